@@ -31,13 +31,49 @@ public:
 	int32 LoadingScreenZOrder = 10000;
 
 	// How long to hold the loading screen up after other loading finishes (in seconds) to
-	// try to give texture streaming a chance to avoid blurriness
+	// try to give texture streaming a chance to avoid blurriness. With bReadinessDrivenHold,
+	// this is the longest the loading screen is held while waiting to be ready.
 	//
 	// Note: This is not normally applied in the editor for iteration time, but can be 
 	// enabled via HoldLoadingScreenAdditionalSecsEvenInEditor
  	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s, ConsoleVariable="CommonLoadingScreen.HoldLoadingScreenAdditionalSecs"))
 	float HoldLoadingScreenAdditionalSecs = 2.0f;
 
+	// When true, the loading screen is only held until async package loads, pending streaming requests and shader
+	// precompiles are done (capped by HoldLoadingScreenAdditionalSecs). Nothing is held when the process cannot render.
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ConsoleVariable="CommonLoadingScreen.ReadinessDrivenHold"))
+	bool bReadinessDrivenHold = true;
+
+	// The minimum number of frames the world is rendered behind a held loading screen, so streaming can work out what it wants
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ClampMin=0, ConsoleVariable="CommonLoadingScreen.HoldMinFrames", EditCondition="bReadinessDrivenHold"))
+	int32 HoldMinFrames = 3;
+
+	// When true, the need for a loading screen is only evaluated while it is up, when something signals a change,
+	// or every FallbackUpdateInterval seconds. When false, it is evaluated every frame.
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ConsoleVariable="CommonLoadingScreen.EventDrivenUpdates"))
+	bool bEventDrivenUpdates = true;
+
+	// The interval in seconds between evaluations of the need for a loading screen when nothing signalled a change
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s, ConsoleVariable="CommonLoadingScreen.FallbackUpdateInterval", EditCondition="bEventDrivenUpdates"))
+	float FallbackUpdateInterval = 0.25f;
+
+	// When true, garbage is collected while the loading screen is held after loading finishes and purged a bit each
+	// frame, instead of a full purge when the loading screen is dropped
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ConsoleVariable="CommonLoadingScreen.IncrementalGC"))
+	bool bIncrementalGarbageCollection = true;
+
+	// The time in milliseconds per frame spent purging garbage while the loading screen is held
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=ms, ConsoleVariable="CommonLoadingScreen.IncrementalGCBudgetMs", EditCondition="bIncrementalGarbageCollection"))
+	float IncrementalGarbageCollectionBudgetMs = 2.0f;
+
+	// Garbage is not collected again when dropping the loading screen if a collection ran within this many seconds
+	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s, ConsoleVariable="CommonLoadingScreen.SkipGCIfCollectedWithinSecs"))
+	float SkipGarbageCollectionIfCollectedWithinSecs = 5.0f;
+
+	// How many loading screen transitions keep their phase timeline for CommonLoadingScreen.DumpTimeline and CommonLoadingScreen.ExportTimelineCSV
+	UPROPERTY(config, EditAnywhere, Category=Debugging, meta=(ClampMin=0, ConsoleVariable="CommonLoadingScreen.TimelineHistorySize"))
+	int32 TimelineHistorySize = 16;
+
 	// The interval in seconds beyond which the loading screen is considered permanently hung (if non-zero).
  	UPROPERTY(config, EditAnywhere, Category=Configuration, meta=(ForceUnits=s))
 	float LoadingScreenHeartbeatHangDuration = 0.0f;
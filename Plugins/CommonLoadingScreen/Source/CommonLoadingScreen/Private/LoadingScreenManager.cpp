@@ -5,12 +5,19 @@
 #include "HAL/ThreadHeartBeat.h"
 
 #include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/WorldInitializationValues.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/Engine.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/WorldSettings.h"
+#include "ContentStreaming.h"
+#include "Misc/App.h"
 #include "Misc/CommandLine.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UObjectGlobals.h"
 
 #include "LoadingProcessInterface.h"
 
@@ -73,9 +80,23 @@ namespace LoadingScreenCVars
 	static FAutoConsoleVariableRef CVarHoldLoadingScreenUpAtLeastThisLongInSecs(
 		TEXT("CommonLoadingScreen.HoldLoadingScreenAdditionalSecs"),
 		HoldLoadingScreenAdditionalSecs,
-		TEXT("How long to hold the loading screen up after other loading finishes (in seconds) to try to give texture streaming a chance to avoid blurriness"),
+		TEXT("How long to hold the loading screen up after other loading finishes (in seconds) to try to give texture streaming a chance to avoid blurriness. The cap on the hold with CommonLoadingScreen.ReadinessDrivenHold."),
 		ECVF_Default | ECVF_Preview);
 
+	static bool ReadinessDrivenHold = true;
+	static FAutoConsoleVariableRef CVarReadinessDrivenHold(
+		TEXT("CommonLoadingScreen.ReadinessDrivenHold"),
+		ReadinessDrivenHold,
+		TEXT("When true, the loading screen is only held until async package loads, pending streaming requests and shader precompiles are done, at most CommonLoadingScreen.HoldLoadingScreenAdditionalSecs. Nothing is held when the process cannot render."),
+		ECVF_Default);
+
+	static int32 HoldMinFrames = 3;
+	static FAutoConsoleVariableRef CVarHoldMinFrames(
+		TEXT("CommonLoadingScreen.HoldMinFrames"),
+		HoldMinFrames,
+		TEXT("The minimum number of frames the world is rendered behind a held loading screen, so streaming can work out what it wants."),
+		ECVF_Default);
+
 	static bool LogLoadingScreenReasonEveryFrame = false;
 	static FAutoConsoleVariableRef CVarLogLoadingScreenReasonEveryFrame(
 		TEXT("CommonLoadingScreen.LogLoadingScreenReasonEveryFrame"),
@@ -89,6 +110,93 @@ namespace LoadingScreenCVars
 		ForceLoadingScreenVisible,
 		TEXT("Force the loading screen to show."),
 		ECVF_Default);
+
+	static bool EventDrivenUpdates = true;
+	static FAutoConsoleVariableRef CVarEventDrivenUpdates(
+		TEXT("CommonLoadingScreen.EventDrivenUpdates"),
+		EventDrivenUpdates,
+		TEXT("When true, the need for a loading screen is only evaluated while it is up, when something signals a change, or every CommonLoadingScreen.FallbackUpdateInterval seconds. When false, it is evaluated every frame."),
+		ECVF_Default);
+
+	static float FallbackUpdateInterval = 0.25f;
+	static FAutoConsoleVariableRef CVarFallbackUpdateInterval(
+		TEXT("CommonLoadingScreen.FallbackUpdateInterval"),
+		FallbackUpdateInterval,
+		TEXT("The interval in seconds between evaluations of the need for a loading screen when nothing signalled a change."),
+		ECVF_Default);
+
+	static bool IncrementalGC = true;
+	static FAutoConsoleVariableRef CVarIncrementalGC(
+		TEXT("CommonLoadingScreen.IncrementalGC"),
+		IncrementalGC,
+		TEXT("When true, garbage is collected while the loading screen is held after loading finishes and purged a bit each frame, instead of a full purge when the loading screen is dropped. Reachability analysis still runs in a single frame."),
+		ECVF_Default);
+
+	static float IncrementalGCBudgetMs = 2.0f;
+	static FAutoConsoleVariableRef CVarIncrementalGCBudgetMs(
+		TEXT("CommonLoadingScreen.IncrementalGCBudgetMs"),
+		IncrementalGCBudgetMs,
+		TEXT("The time in milliseconds per frame spent purging garbage while the loading screen is held."),
+		ECVF_Default);
+
+	static float SkipGCIfCollectedWithinSecs = 5.0f;
+	static FAutoConsoleVariableRef CVarSkipGCIfCollectedWithinSecs(
+		TEXT("CommonLoadingScreen.SkipGCIfCollectedWithinSecs"),
+		SkipGCIfCollectedWithinSecs,
+		TEXT("Garbage is not collected again when dropping the loading screen if a collection ran within this many seconds."),
+		ECVF_Default);
+
+	static int32 TimelineHistorySize = 16;
+	static FAutoConsoleVariableRef CVarTimelineHistorySize(
+		TEXT("CommonLoadingScreen.TimelineHistorySize"),
+		TimelineHistorySize,
+		TEXT("How many loading screen transitions keep their phase timeline for CommonLoadingScreen.DumpTimeline and CommonLoadingScreen.ExportTimelineCSV. 0 keeps none."),
+		ECVF_Default);
+
+	// Commands
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdDumpTimeline(
+		TEXT("CommonLoadingScreen.DumpTimeline"),
+		TEXT("Prints the phase timeline of the most recent loading screen transitions. Usage: CommonLoadingScreen.DumpTimeline [NumTransitions=1]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			const ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr;
+			if (LoadingScreenManager == nullptr)
+			{
+				Ar.Logf(TEXT("No loading screen manager for this world."));
+				return;
+			}
+
+			const int32 NumTimelines = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1;
+			LoadingScreenManager->GetTimelineHistory().Dump(Ar, NumTimelines);
+		}));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdExportTimelineCSV(
+		TEXT("CommonLoadingScreen.ExportTimelineCSV"),
+		TEXT("Writes the phase timelines of the recorded loading screen transitions to a CSV file, one row per phase. Usage: CommonLoadingScreen.ExportTimelineCSV [Filename]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			const ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr;
+			if (LoadingScreenManager == nullptr)
+			{
+				Ar.Logf(TEXT("No loading screen manager for this world."));
+				return;
+			}
+
+			const FString Filename = (Args.Num() > 0)
+				? Args[0]
+				: FPaths::ProfilingDir() / TEXT("LoadingScreen") / FString::Printf(TEXT("LoadingTimeline-%s.csv"), *FDateTime::Now().ToString());
+
+			if (LoadingScreenManager->GetTimelineHistory().ExportCSV(Filename))
+			{
+				Ar.Logf(TEXT("Wrote loading screen timeline to %s"), *FPaths::ConvertRelativePathToFull(Filename));
+			}
+			else
+			{
+				Ar.Logf(ELogVerbosity::Error, TEXT("Failed to write loading screen timeline to %s"), *Filename);
+			}
+		}));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -130,9 +238,19 @@ void ULoadingScreenManager::Initialize(FSubsystemCollectionBase& Collection)
 	FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &ThisClass::HandlePreLoadMap);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
 
-	const UGameInstance* LocalGameInstance = GetGameInstance();
+	// Anything that can change the need for a loading screen marks the state dirty, see ShouldUpdateLoadingScreen
+	FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &ThisClass::HandlePostWorldInitialization);
+	FWorldDelegates::OnSeamlessTravelStart.AddUObject(this, &ThisClass::HandleSeamlessTravelStart);
+	FWorldDelegates::OnSeamlessTravelTransition.AddUObject(this, &ThisClass::HandleSeamlessTravelTransition);
+	GEngine->OnTravelFailure().AddUObject(this, &ThisClass::HandleTravelFailure);
+	GEngine->OnNetworkFailure().AddUObject(this, &ThisClass::HandleNetworkFailure);
+
+	UGameInstance* LocalGameInstance = GetGameInstance();
 	check(LocalGameInstance);
 
+	LocalGameInstance->OnLocalPlayerAddedEvent.AddUObject(this, &ThisClass::HandleLocalPlayerChanged);
+	LocalGameInstance->OnLocalPlayerRemovedEvent.AddUObject(this, &ThisClass::HandleLocalPlayerChanged);
+
 	// Create the loading screen widget 
 	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
 	LoadingScreenWidgetClass = Settings->LoadingScreenWidget.TryLoadClass<UUserWidget>();
@@ -144,8 +262,23 @@ void ULoadingScreenManager::Deinitialize()
 
 	RemoveWidgetFromViewport();
 
-	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
+	FCoreUObjectDelegates::PreLoadMapWithContext.RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+	FWorldDelegates::OnSeamlessTravelStart.RemoveAll(this);
+	FWorldDelegates::OnSeamlessTravelTransition.RemoveAll(this);
+
+	if (GEngine)
+	{
+		GEngine->OnTravelFailure().RemoveAll(this);
+		GEngine->OnNetworkFailure().RemoveAll(this);
+	}
+
+	if (UGameInstance* LocalGameInstance = GetGameInstance())
+	{
+		LocalGameInstance->OnLocalPlayerAddedEvent.RemoveAll(this);
+		LocalGameInstance->OnLocalPlayerRemovedEvent.RemoveAll(this);
+	}
 }
 
 bool ULoadingScreenManager::ShouldCreateSubsystem(UObject* Outer) const
@@ -158,7 +291,12 @@ bool ULoadingScreenManager::ShouldCreateSubsystem(UObject* Outer) const
 
 void ULoadingScreenManager::Tick(float DeltaTime)
 {
-	UpdateLoadingScreen();
+	TimeUntilNextFallbackUpdateSeconds -= DeltaTime;
+
+	if (ShouldUpdateLoadingScreen())
+	{
+		UpdateLoadingScreen();
+	}
 
 	TimeUntilNextLogHeartbeatSeconds = FMath::Max(TimeUntilNextLogHeartbeatSeconds - DeltaTime, 0.0);
 }
@@ -186,11 +324,18 @@ UWorld* ULoadingScreenManager::GetTickableGameObjectWorld() const
 void ULoadingScreenManager::RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Add(Interface.GetObject());
+	MarkLoadingScreenStateDirty();
 }
 
 void ULoadingScreenManager::UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Remove(Interface.GetObject());
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::MarkLoadingScreenStateDirty()
+{
+	bLoadingScreenStateDirty = true;
 }
 
 void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
@@ -199,6 +344,14 @@ void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext,
 	{
 		bCurrentlyInLoadMap = true;
 
+		// A new transition starts here unless the loading screen is already up for one, e.g. for pending travel
+		if (!bCurrentlyShowingLoadingScreen)
+		{
+			TimelineHistory.BeginTimeline(MapName);
+		}
+		TimelineHistory.SetMapName(MapName);
+		RecordTimelineEvent(TEXT("PreLoadMap"), MapName);
+
 		// Update the loading screen immediately if the engine is initialized
 		if (GEngine->IsInitialized())
 		{
@@ -212,22 +365,112 @@ void ULoadingScreenManager::HandlePostLoadMap(UWorld* World)
 	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
 	{
 		bCurrentlyInLoadMap = false;
+		RecordTimelineEvent(TEXT("PostLoadMap"), World->GetMapName());
+		MarkLoadingScreenStateDirty();
 	}
 }
 
+void ULoadingScreenManager::HandlePostWorldInitialization(UWorld* World, const FWorldInitializationValues IVS)
+{
+	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
+	{
+		World->OnWorldBeginPlay.AddUObject(this, &ThisClass::HandleWorldBeginPlay);
+		World->GameStateSetEvent.AddUObject(this, &ThisClass::HandleGameStateSet);
+		MarkLoadingScreenStateDirty();
+	}
+}
+
+void ULoadingScreenManager::HandleWorldBeginPlay()
+{
+	RecordTimelineEvent(TEXT("WorldBeginPlay"));
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::HandleGameStateSet(AGameStateBase* GameState)
+{
+	RecordTimelineEvent(TEXT("GameStateSet"), GetNameSafe(GameState));
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::HandleSeamlessTravelStart(UWorld* World, const FString& MapName)
+{
+	TimelineHistory.SetMapName(MapName);
+	RecordTimelineEvent(TEXT("SeamlessTravelStart"), MapName);
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::HandleSeamlessTravelTransition(UWorld* World)
+{
+	RecordTimelineEvent(TEXT("SeamlessTravelTransition"));
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::HandleLocalPlayerChanged(ULocalPlayer* LocalPlayer)
+{
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+	RecordTimelineEvent(TEXT("TravelFailure"), ErrorString);
+	MarkLoadingScreenStateDirty();
+}
+
+void ULoadingScreenManager::HandleNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
+{
+	RecordTimelineEvent(TEXT("NetworkFailure"), ErrorString);
+	MarkLoadingScreenStateDirty();
+}
+
+bool ULoadingScreenManager::ShouldUpdateLoadingScreen() const
+{
+	if (!LoadingScreenCVars::EventDrivenUpdates || LoadingScreenCVars::LogLoadingScreenReasonEveryFrame)
+	{
+		return true;
+	}
+
+	// While the screen is up every frame counts, it should drop as soon as nothing needs it anymore
+	if (bLoadingScreenStateDirty || bCurrentlyShowingLoadingScreen)
+	{
+		return true;
+	}
+
+	// Catches the things that do not signal their changes, e.g. pending travel or loading processor components
+	return TimeUntilNextFallbackUpdateSeconds <= 0.0;
+}
+
 void ULoadingScreenManager::UpdateLoadingScreen()
 {
+	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
+
+	bLoadingScreenStateDirty = false;
+	TimeUntilNextFallbackUpdateSeconds = LoadingScreenCVars::FallbackUpdateInterval;
+
 	bool bLogLoadingScreenStatus = LoadingScreenCVars::LogLoadingScreenReasonEveryFrame;
+	const bool bHeartbeatLogDue = bCurrentlyShowingLoadingScreen && (Settings->LogLoadingScreenHeartbeatInterval > 0.0f) && (TimeUntilNextLogHeartbeatSeconds <= 0.0);
+
+	// The reason is only put together when it is going to be logged
+	const bool bWantReason = bLogLoadingScreenStatus || bHeartbeatLogDue;
+	bool bShowLoadingScreen = ShouldShowLoadingScreen(bWantReason ? &DebugReasonForShowingOrHidingLoadingScreen : nullptr);
+	if (!bWantReason && (bShowLoadingScreen != bCurrentlyShowingLoadingScreen))
+	{
+		// Showing and hiding log why, evaluate once more for the reason
+		bShowLoadingScreen = ShouldShowLoadingScreen(&DebugReasonForShowingOrHidingLoadingScreen);
+	}
 
-	if (ShouldShowLoadingScreen())
+	if (bShowLoadingScreen)
 	{
-		const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
-		
 		// If we don't make it to the specified checkpoint in the given time will trigger the hang detector so we can better determine where progress stalled.
  		FThreadHeartBeat::Get().MonitorCheckpointStart(GetFName(), Settings->LoadingScreenHeartbeatHangDuration);
 
 		ShowLoadingScreen();
 
+		// Once nothing needs the screen anymore it is only being held, a good time to deal with the garbage the load left behind
+		if (bCurrentlyShowingLoadingScreen && (TimeLoadingScreenLastDismissed >= 0.0))
+		{
+			UpdateGarbageCollectionWhileHeld();
+		}
+
  		if ((Settings->LogLoadingScreenHeartbeatInterval > 0.0f) && (TimeUntilNextLogHeartbeatSeconds <= 0.0))
  		{
 			bLogLoadingScreenStatus = true;
@@ -236,6 +479,11 @@ void ULoadingScreenManager::UpdateLoadingScreen()
 	}
 	else
 	{
+		if (bCurrentlyShowingLoadingScreen)
+		{
+			RecordTimelineEvent(TEXT("HoldEnd"), HoldEndReason);
+		}
+
 		HideLoadingScreen();
  
  		FThreadHeartBeat::Get().MonitorCheckpointEnd(GetFName());
@@ -247,16 +495,41 @@ void ULoadingScreenManager::UpdateLoadingScreen()
 	}
 }
 
-bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
+bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen(FString* OutReason, UObject** OutBlockingProcessor) const
 {
+	// Reasons are only built when asked for, loading processors still need somewhere to write theirs
+	FString UnusedProcessorReason;
+	FString& ProcessorReason = OutReason ? *OutReason : UnusedProcessorReason;
+
+	const auto SetReason = [OutReason](const TCHAR* Reason)
+	{
+		if (OutReason)
+		{
+			*OutReason = Reason;
+		}
+	};
+
+	const auto IsProcessorBlocking = [OutBlockingProcessor, &ProcessorReason](UObject* TestObject)
+	{
+		if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestObject, /*out*/ ProcessorReason))
+		{
+			if (OutBlockingProcessor)
+			{
+				*OutBlockingProcessor = TestObject;
+			}
+			return true;
+		}
+		return false;
+	};
+
 	// Start out with 'unknown' reason in case someone forgets to put a reason when changing this in the future.
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("Reason for Showing/Hiding LoadingScreen is unknown!");
+	SetReason(TEXT("Reason for Showing/Hiding LoadingScreen is unknown!"));
 
 	const UGameInstance* LocalGameInstance = GetGameInstance();
 
 	if (LoadingScreenCVars::ForceLoadingScreenVisible)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("CommonLoadingScreen.AlwaysShow is true"));
+		SetReason(TEXT("CommonLoadingScreen.AlwaysShow is true"));
 		return true;
 	}
 
@@ -264,14 +537,14 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	if (Context == nullptr)
 	{
 		// We don't have a world context right now... better show a loading screen
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("The game instance has a null WorldContext"));
+		SetReason(TEXT("The game instance has a null WorldContext"));
 		return true;
 	}
 
 	UWorld* World = Context->World();
 	if (World == nullptr)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We have no world (FWorldContext's World() is null)"));
+		SetReason(TEXT("We have no world (FWorldContext's World() is null)"));
 		return true;
 	}
 
@@ -279,46 +552,46 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	if (GameState == nullptr)
 	{
 		// The game state has not yet replicated.
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("GameState hasn't yet replicated (it's null)"));
+		SetReason(TEXT("GameState hasn't yet replicated (it's null)"));
 		return true;
 	}
 
 	if (bCurrentlyInLoadMap)
 	{
 		// Show a loading screen if we are in LoadMap
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("bCurrentlyInLoadMap is true"));
+		SetReason(TEXT("bCurrentlyInLoadMap is true"));
 		return true;
 	}
 
 	if (!Context->TravelURL.IsEmpty())
 	{
 		// Show a loading screen when pending travel
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We have pending travel (the TravelURL is not empty)"));
+		SetReason(TEXT("We have pending travel (the TravelURL is not empty)"));
 		return true;
 	}
 
 	if (Context->PendingNetGame != nullptr)
 	{
 		// Connecting to another server
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We are connecting to another server (PendingNetGame != nullptr)"));
+		SetReason(TEXT("We are connecting to another server (PendingNetGame != nullptr)"));
 		return true;
 	}
 
 	if (!World->HasBegunPlay())
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("World hasn't begun play"));
+		SetReason(TEXT("World hasn't begun play"));
 		return true;
 	}
 
 	if (World->IsInSeamlessTravel())
 	{
 		// Show a loading screen during seamless travel
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We are in seamless travel"));
+		SetReason(TEXT("We are in seamless travel"));
 		return true;
 	}
 
 	// Ask the game state if it needs a loading screen	
-	if (ILoadingProcessInterface::ShouldShowLoadingScreen(GameState, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+	if (IsProcessorBlocking(GameState))
 	{
 		return true;
 	}
@@ -326,7 +599,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	// Ask any game state components if they need a loading screen
 	for (UActorComponent* TestComponent : GameState->GetComponents())
 	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+		if (IsProcessorBlocking(TestComponent))
 		{
 			return true;
 		}
@@ -337,7 +610,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	// streaming in.
 	for (const TWeakInterfacePtr<ILoadingProcessInterface>& Processor : ExternalLoadingProcessors)
 	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor.GetObject(), /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+		if (IsProcessorBlocking(Processor.GetObject()))
 		{
 			return true;
 		}
@@ -356,7 +629,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 				bFoundAnyLocalPC = true;
 
 				// Ask the PC itself if it needs a loading screen
-				if (ILoadingProcessInterface::ShouldShowLoadingScreen(PC, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+				if (IsProcessorBlocking(PC))
 				{
 					return true;
 				}
@@ -364,7 +637,7 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 				// Ask any PC components if they need a loading screen
 				for (UActorComponent* TestComponent : PC->GetComponents())
 				{
-					if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+					if (IsProcessorBlocking(TestComponent))
 					{
 						return true;
 					}
@@ -383,23 +656,23 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	// In splitscreen we need all player controllers to be present
 	if (bIsInSplitscreen && bMissingAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("At least one missing local player controller in splitscreen"));
+		SetReason(TEXT("At least one missing local player controller in splitscreen"));
 		return true;
 	}
 
 	// And in non-splitscreen we need at least one player controller to be present
 	if (!bIsInSplitscreen && !bFoundAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("Need at least one local player controller"));
+		SetReason(TEXT("Need at least one local player controller"));
 		return true;
 	}
 
 	// Victory! The loading screen can go away now
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("(nothing wants to show it anymore)");
+	SetReason(TEXT("(nothing wants to show it anymore)"));
 	return false;
 }
 
-bool ULoadingScreenManager::ShouldShowLoadingScreen()
+bool ULoadingScreenManager::ShouldShowLoadingScreen(FString* OutReason)
 {
 	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
 
@@ -408,19 +681,28 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 	static bool bCmdLineNoLoadingScreen = FParse::Param(FCommandLine::Get(), TEXT("NoLoadingScreen"));
 	if (bCmdLineNoLoadingScreen)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("CommandLine has 'NoLoadingScreen'"));
+		if (OutReason)
+		{
+			*OutReason = TEXT("CommandLine has 'NoLoadingScreen'");
+		}
 		return false;
 	}
 #endif
 
 	// Check for a need to show the loading screen
-	const bool bNeedToShowLoadingScreen = CheckForAnyNeedToShowLoadingScreen();
+	UObject* BlockingProcessor = nullptr;
+	const bool bNeedToShowLoadingScreen = CheckForAnyNeedToShowLoadingScreen(OutReason, &BlockingProcessor);
+	UpdateTimelineBlockingProcessor(BlockingProcessor);
 
 	// Keep the loading screen up a bit longer if desired
 	bool bWantToForceShowLoadingScreen = false;
 	if (bNeedToShowLoadingScreen)
 	{
 		// Still need to show it
+		if (TimeLoadingScreenLastDismissed >= 0.0)
+		{
+			RecordTimelineEvent(TEXT("HoldCancelled"));
+		}
 		TimeLoadingScreenLastDismissed = -1.0;
 	}
 	else
@@ -433,25 +715,110 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 		if (TimeLoadingScreenLastDismissed < 0.0)
 		{
 			TimeLoadingScreenLastDismissed = CurrentTime;
+			FrameLoadingScreenLastDismissed = GFrameCounter;
+			RecordTimelineEvent(TEXT("HoldStart"));
 		}
 		const double TimeSinceScreenDismissed = CurrentTime - TimeLoadingScreenLastDismissed;
 
-		// hold for an extra X seconds, to cover up streaming
-		if ((HoldLoadingScreenAdditionalSecs > 0.0) && (TimeSinceScreenDismissed < HoldLoadingScreenAdditionalSecs))
+		// hold for an extra X seconds, to cover up streaming, or until streaming is done if that comes first
+		FString ReadinessReason;
+		if ((HoldLoadingScreenAdditionalSecs > 0.0) && (TimeSinceScreenDismissed < HoldLoadingScreenAdditionalSecs) && !IsReadyToDropLoadingScreen(OutReason ? &ReadinessReason : nullptr))
 		{
 			// Make sure we're rendering the world at this point, so that textures will actually stream in
 			//@TODO: If bNeedToShowLoadingScreen bounces back true during this window, we won't turn this off again...
 			UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
 			GameViewportClient->bDisableWorldRendering = false;
 
-			DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+			if (OutReason)
+			{
+				*OutReason = LoadingScreenCVars::ReadinessDrivenHold
+					? FString::Printf(TEXT("Keeping loading screen up for at most %.2f more seconds, waiting on %s"), HoldLoadingScreenAdditionalSecs - TimeSinceScreenDismissed, *ReadinessReason)
+					: FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+			}
 			bWantToForceShowLoadingScreen = true;
 		}
+		else
+		{
+			HoldEndReason = (HoldLoadingScreenAdditionalSecs <= 0.0) ? TEXT("no hold")
+				: (TimeSinceScreenDismissed >= HoldLoadingScreenAdditionalSecs) ? TEXT("hold time ran out")
+				: TEXT("ready");
+		}
 	}
 
 	return bNeedToShowLoadingScreen || bWantToForceShowLoadingScreen;
 }
 
+bool ULoadingScreenManager::IsReadyToDropLoadingScreen(FString* OutReason) const
+{
+	if (!LoadingScreenCVars::ReadinessDrivenHold)
+	{
+		// The fixed hold, only the time runs it out
+		if (OutReason)
+		{
+			*OutReason = TEXT("the fixed hold time");
+		}
+		return false;
+	}
+
+	// Headless runs have nothing to stream in for the screen to hide
+	if (!FApp::CanEverRender())
+	{
+		return true;
+	}
+
+	// The world has to render for a few frames before the streaming manager knows what it wants
+	if ((GFrameCounter - FrameLoadingScreenLastDismissed) < uint64(FMath::Max(LoadingScreenCVars::HoldMinFrames, 0)))
+	{
+		if (OutReason)
+		{
+			*OutReason = TEXT("the world to render its first frames");
+		}
+		return false;
+	}
+
+	const int32 NumAsyncPackages = GetNumAsyncPackages();
+	const int32 NumWantingResources = IStreamingManager::Get().GetNumWantingResources();
+	const uint32 NumPrecompilesRemaining = FShaderPipelineCache::NumPrecompilesRemaining();
+	if ((NumAsyncPackages > 0) || (NumWantingResources > 0) || (NumPrecompilesRemaining > 0))
+	{
+		if (OutReason)
+		{
+			*OutReason = FString::Printf(TEXT("%d async package loads, %d streaming resources and %u shader precompiles"), NumAsyncPackages, NumWantingResources, NumPrecompilesRemaining);
+		}
+		return false;
+	}
+
+	return true;
+}
+
+void ULoadingScreenManager::RecordTimelineEvent(const TCHAR* Phase, FString Detail)
+{
+	TimelineHistory.AddEvent(Phase, MoveTemp(Detail));
+}
+
+void ULoadingScreenManager::UpdateTimelineBlockingProcessor(UObject* BlockingProcessor)
+{
+	// A processor that went away without letting go is also released
+	if ((TimelineBlockingProcessor.Get() == BlockingProcessor) && ((BlockingProcessor != nullptr) || TimelineBlockingProcessorName.IsEmpty()))
+	{
+		return;
+	}
+
+	// The name is kept as the processor may be gone by the time it lets go
+	if (!TimelineBlockingProcessorName.IsEmpty())
+	{
+		RecordTimelineEvent(TEXT("ProcessorReleased"), TimelineBlockingProcessorName);
+	}
+
+	TimelineBlockingProcessor = BlockingProcessor;
+	TimelineBlockingProcessorName = BlockingProcessor ? BlockingProcessor->GetPathName() : FString();
+
+	if (BlockingProcessor)
+	{
+		RecordTimelineEvent(TEXT("ProcessorBlocking"), TimelineBlockingProcessorName);
+	}
+}
+
 bool ULoadingScreenManager::IsShowingInitialLoadingScreen() const
 {
 	FPreLoadScreenManager* PreLoadScreenManager = FPreLoadScreenManager::Get();
@@ -473,7 +840,23 @@ void ULoadingScreenManager::ShowLoadingScreen()
 
 	TimeLoadingScreenShown = FPlatformTime::Seconds();
 
+	if (!TimelineHistory.IsRecording())
+	{
+		const UWorld* World = GetGameInstance()->GetWorld();
+		TimelineHistory.BeginTimeline(World ? World->GetMapName() : FString());
+
+		// The processor may have asked for the loading screen before there was a timeline to record it in
+		if (!TimelineBlockingProcessorName.IsEmpty())
+		{
+			RecordTimelineEvent(TEXT("ProcessorBlocking"), TimelineBlockingProcessorName);
+		}
+	}
+	RecordTimelineEvent(TEXT("Show"), DebugReasonForShowingOrHidingLoadingScreen);
+
 	bCurrentlyShowingLoadingScreen = true;
+	bStartedLoadingScreenGarbageCollection = false;
+	LoadingScreenPurgeSeconds = 0.0;
+	LoadingScreenPurgeFrames = 0;
 
 	CSV_EVENT(LoadingScreen, TEXT("Show"));
 
@@ -540,8 +923,26 @@ void ULoadingScreenManager::HideLoadingScreen()
 		UE_LOG(LogLoadingScreen, Log, TEXT("Hiding loading screen when 'IsShowingInitialLoadingScreen()' is false."));
 		UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *DebugReasonForShowingOrHidingLoadingScreen);
 
-		UE_LOG(LogLoadingScreen, Log, TEXT("Garbage Collecting before dropping load screen"));
-		GEngine->ForceGarbageCollection(true);
+		if (IsIncrementalPurgePending())
+		{
+			// Whatever the held frames did not get to is purged now, the collection itself already happened
+			const double PurgeStartTime = FPlatformTime::Seconds();
+			IncrementalPurgeGarbage(/*bUseTimeLimit=*/ false);
+			UE_LOG(LogLoadingScreen, Log, TEXT("Finished purging garbage before dropping load screen in %.2f ms (%.2f ms over %d held frames before)"),
+				(FPlatformTime::Seconds() - PurgeStartTime) * 1000.0, LoadingScreenPurgeSeconds * 1000.0, LoadingScreenPurgeFrames);
+			RecordTimelineEvent(TEXT("GCPurgeFinished"));
+		}
+		else if (HasCollectedGarbageRecently())
+		{
+			UE_LOG(LogLoadingScreen, Log, TEXT("Skipping garbage collection before dropping load screen, last collection was %.2fs ago"), FPlatformTime::Seconds() - GetLastGCTime());
+			RecordTimelineEvent(TEXT("GCSkipped"));
+		}
+		else
+		{
+			UE_LOG(LogLoadingScreen, Log, TEXT("Garbage Collecting before dropping load screen"));
+			RecordTimelineEvent(TEXT("GCRequested"));
+			GEngine->ForceGarbageCollection(true);
+		}
 
 		RemoveWidgetFromViewport();
 	
@@ -556,9 +957,65 @@ void ULoadingScreenManager::HideLoadingScreen()
 	const double LoadingScreenDuration = FPlatformTime::Seconds() - TimeLoadingScreenShown;
 	UE_LOG(LogLoadingScreen, Log, TEXT("LoadingScreen was visible for %.2fs"), LoadingScreenDuration);
 
+	RecordTimelineEvent(TEXT("Hide"));
+	TimelineHistory.EndTimeline(LoadingScreenCVars::TimelineHistorySize);
+	UpdateTimelineBlockingProcessor(nullptr);
+
 	bCurrentlyShowingLoadingScreen = false;
 }
 
+void ULoadingScreenManager::UpdateGarbageCollectionWhileHeld()
+{
+	if (!LoadingScreenCVars::IncrementalGC || IsShowingInitialLoadingScreen())
+	{
+		return;
+	}
+
+	if (!bStartedLoadingScreenGarbageCollection)
+	{
+		bStartedLoadingScreenGarbageCollection = true;
+
+		if (HasCollectedGarbageRecently())
+		{
+			UE_LOG(LogLoadingScreen, Log, TEXT("Skipping garbage collection behind the loading screen, last collection was %.2fs ago"), FPlatformTime::Seconds() - GetLastGCTime());
+			RecordTimelineEvent(TEXT("GCSkipped"));
+			return;
+		}
+
+		// Only the purge is budgeted: reachability analysis runs in one go here, while nothing is playing, and the purge is
+		// spread over the held frames
+		const double CollectStartTime = FPlatformTime::Seconds();
+		RecordTimelineEvent(TEXT("GCStart"));
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, /*bPerformFullPurge=*/ false);
+		RecordTimelineEvent(TEXT("GCCollected"));
+		UE_LOG(LogLoadingScreen, Log, TEXT("Collected garbage behind the loading screen in %.2f ms (reachability, not budgeted), purging with a budget of %.2f ms per frame"),
+			(FPlatformTime::Seconds() - CollectStartTime) * 1000.0, LoadingScreenCVars::IncrementalGCBudgetMs);
+		return;
+	}
+
+	if (IsIncrementalPurgePending())
+	{
+		const double PurgeStartTime = FPlatformTime::Seconds();
+		IncrementalPurgeGarbage(/*bUseTimeLimit=*/ true, FMath::Max(LoadingScreenCVars::IncrementalGCBudgetMs, 0.1f) / 1000.0f);
+		LoadingScreenPurgeSeconds += FPlatformTime::Seconds() - PurgeStartTime;
+		++LoadingScreenPurgeFrames;
+
+		if (!IsIncrementalPurgePending())
+		{
+			UE_LOG(LogLoadingScreen, Log, TEXT("Purged garbage behind the loading screen in %.2f ms over %d frames"), LoadingScreenPurgeSeconds * 1000.0, LoadingScreenPurgeFrames);
+			RecordTimelineEvent(TEXT("GCPurgeFinished"), FString::Printf(TEXT("%.2f ms over %d frames"), LoadingScreenPurgeSeconds * 1000.0, LoadingScreenPurgeFrames));
+		}
+	}
+}
+
+bool ULoadingScreenManager::HasCollectedGarbageRecently() const
+{
+	// Only a collection made once the load was done counts, the one LoadMap runs happens before the new map's garbage exists
+	const double LoadFinishedTime = (TimeLoadingScreenLastDismissed >= 0.0) ? TimeLoadingScreenLastDismissed : FPlatformTime::Seconds();
+	const double LastGCTime = GetLastGCTime();
+	return (LastGCTime > LoadFinishedTime) && ((FPlatformTime::Seconds() - LastGCTime) < LoadingScreenCVars::SkipGCIfCollectedWithinSecs);
+}
+
 void ULoadingScreenManager::RemoveWidgetFromViewport()
 {
 	UGameInstance* LocalGameInstance = GetGameInstance();
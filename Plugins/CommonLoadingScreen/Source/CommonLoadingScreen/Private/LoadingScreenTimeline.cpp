@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LoadingScreenTimeline.h"
+
+#include "Algo/Rotate.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/StringBuilder.h"
+
+namespace LoadingScreenTimeline
+{
+	static FString EscapeCSVField(const FString& Field)
+	{
+		if (Field.Contains(TEXT(",")) || Field.Contains(TEXT("\"")) || Field.Contains(TEXT("\n")))
+		{
+			return FString::Printf(TEXT("\"%s\""), *Field.Replace(TEXT("\""), TEXT("\"\"")));
+		}
+		return Field;
+	}
+}
+
+void FLoadingScreenTimelineHistory::BeginTimeline(const FString& MapName)
+{
+	CurrentTimeline = FLoadingScreenTimeline();
+	CurrentTimeline.MapName = MapName;
+	CurrentTimeline.StartDateTime = FDateTime::Now();
+	CurrentTimeline.StartTime = FPlatformTime::Seconds();
+	CurrentTimeline.StartFrame = GFrameCounter;
+	bRecording = true;
+}
+
+void FLoadingScreenTimelineHistory::SetMapName(const FString& MapName)
+{
+	if (bRecording)
+	{
+		CurrentTimeline.MapName = MapName;
+	}
+}
+
+void FLoadingScreenTimelineHistory::AddEvent(const TCHAR* Phase, FString Detail)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FLoadingScreenTimelineEvent& Event = CurrentTimeline.Events.AddDefaulted_GetRef();
+	Event.Phase = Phase;
+	Event.Detail = MoveTemp(Detail);
+	Event.Seconds = FPlatformTime::Seconds() - CurrentTimeline.StartTime;
+	Event.Frames = GFrameCounter - CurrentTimeline.StartFrame;
+}
+
+void FLoadingScreenTimelineHistory::EndTimeline(int32 MaxTimelines)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	bRecording = false;
+	CurrentTimeline.DurationSeconds = FPlatformTime::Seconds() - CurrentTimeline.StartTime;
+	CurrentTimeline.DurationFrames = GFrameCounter - CurrentTimeline.StartFrame;
+
+	if (MaxTimelines <= 0)
+	{
+		Timelines.Empty();
+		NextTimelineIndex = 0;
+		return;
+	}
+
+	if (Timelines.Num() == MaxTimelines)
+	{
+		// Full, the new transition takes the place of the oldest one
+		Timelines[NextTimelineIndex] = MoveTemp(CurrentTimeline);
+		NextTimelineIndex = (NextTimelineIndex + 1) % MaxTimelines;
+		return;
+	}
+
+	// The size changed or the buffer is still filling up, put the transitions back in order before growing or shrinking
+	Algo::Rotate(Timelines, NextTimelineIndex);
+	NextTimelineIndex = 0;
+
+	if (Timelines.Num() >= MaxTimelines)
+	{
+		Timelines.RemoveAt(0, Timelines.Num() - MaxTimelines + 1);
+	}
+	Timelines.Add(MoveTemp(CurrentTimeline));
+}
+
+TArray<const FLoadingScreenTimeline*> FLoadingScreenTimelineHistory::GetTimelines() const
+{
+	TArray<const FLoadingScreenTimeline*> Result;
+	Result.Reserve(Timelines.Num());
+	for (int32 Index = 0; Index < Timelines.Num(); ++Index)
+	{
+		Result.Add(&Timelines[(NextTimelineIndex + Index) % Timelines.Num()]);
+	}
+	return Result;
+}
+
+void FLoadingScreenTimelineHistory::Dump(FOutputDevice& Ar, int32 NumTimelines) const
+{
+	const TArray<const FLoadingScreenTimeline*> OrderedTimelines = GetTimelines();
+	if (OrderedTimelines.IsEmpty())
+	{
+		Ar.Logf(TEXT("No loading screen transitions recorded yet."));
+		return;
+	}
+
+	const int32 FirstTimeline = FMath::Max(OrderedTimelines.Num() - FMath::Max(NumTimelines, 1), 0);
+	for (int32 TimelineIndex = FirstTimeline; TimelineIndex < OrderedTimelines.Num(); ++TimelineIndex)
+	{
+		const FLoadingScreenTimeline& Timeline = *OrderedTimelines[TimelineIndex];
+		Ar.Logf(TEXT("Loading screen transition %d to '%s' at %s: %.2fs, %llu frames"),
+			TimelineIndex, *Timeline.MapName, *Timeline.StartDateTime.ToString(), Timeline.DurationSeconds, Timeline.DurationFrames);
+
+		// The time before a phase is the time spent waiting for it, the longest wait is usually what to look at
+		double PreviousSeconds = 0.0;
+		double LongestWaitSeconds = -1.0;
+		const FLoadingScreenTimelineEvent* LongestWaitEvent = nullptr;
+		for (const FLoadingScreenTimelineEvent& Event : Timeline.Events)
+		{
+			const double WaitSeconds = Event.Seconds - PreviousSeconds;
+			Ar.Logf(TEXT("  %8.3fs  +%9.2fms  frame %6llu  %-28s %s"), Event.Seconds, WaitSeconds * 1000.0, Event.Frames, *Event.Phase, *Event.Detail);
+
+			if (WaitSeconds > LongestWaitSeconds)
+			{
+				LongestWaitSeconds = WaitSeconds;
+				LongestWaitEvent = &Event;
+			}
+			PreviousSeconds = Event.Seconds;
+		}
+
+		if (LongestWaitEvent)
+		{
+			Ar.Logf(TEXT("  Longest wait: %.2fms before %s %s"), LongestWaitSeconds * 1000.0, *LongestWaitEvent->Phase, *LongestWaitEvent->Detail);
+		}
+	}
+}
+
+bool FLoadingScreenTimelineHistory::ExportCSV(const FString& Filename) const
+{
+	using namespace LoadingScreenTimeline;
+
+	TStringBuilder<4096> CSV;
+	CSV << TEXT("Transition,Map,StartTime,Phase,Detail,Seconds,Frames,SincePreviousMs\n");
+
+	const TArray<const FLoadingScreenTimeline*> OrderedTimelines = GetTimelines();
+	for (int32 TimelineIndex = 0; TimelineIndex < OrderedTimelines.Num(); ++TimelineIndex)
+	{
+		const FLoadingScreenTimeline& Timeline = *OrderedTimelines[TimelineIndex];
+		const FString MapName = EscapeCSVField(Timeline.MapName);
+		const FString StartTime = Timeline.StartDateTime.ToIso8601();
+
+		double PreviousSeconds = 0.0;
+		for (const FLoadingScreenTimelineEvent& Event : Timeline.Events)
+		{
+			CSV.Appendf(TEXT("%d,%s,%s,%s,%s,%.6f,%llu,%.3f\n"), TimelineIndex, *MapName, *StartTime, *EscapeCSVField(Event.Phase), *EscapeCSVField(Event.Detail),
+				Event.Seconds, Event.Frames, (Event.Seconds - PreviousSeconds) * 1000.0);
+			PreviousSeconds = Event.Seconds;
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(CSV.ToView(), *Filename);
+}
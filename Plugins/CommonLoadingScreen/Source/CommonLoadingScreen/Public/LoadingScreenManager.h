@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Engine/EngineBaseTypes.h"
+#include "LoadingScreenTimeline.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Tickable.h"
 #include "UObject/WeakInterfacePtr.h"
@@ -11,17 +13,26 @@
 template <typename InterfaceType> class TScriptInterface;
 
 class FSubsystemCollectionBase;
+class AGameStateBase;
 class IInputProcessor;
 class ILoadingProcessInterface;
+class ULocalPlayer;
+class UNetDriver;
 class SWidget;
 class UObject;
 class UWorld;
 struct FFrame;
 struct FWorldContext;
+struct FWorldInitializationValues;
 class UUserWidget;
 
 /**
  * Handles showing/hiding the loading screen
+ *
+ * While the loading screen is up, the need for it is evaluated every frame. While it is down, it is only evaluated when
+ * something marks the state dirty (map loads, world begin play, game state changes, travel, local players coming and
+ * going, loading processors registering) or every CommonLoadingScreen.FallbackUpdateInterval seconds for anything that
+ * does not signal its changes. CommonLoadingScreen.EventDrivenUpdates=0 goes back to evaluating every frame.
  */
 UCLASS()
 class COMMONLOADINGSCREEN_API ULoadingScreenManager : public UGameInstanceSubsystem, public FTickableGameObject
@@ -43,12 +54,17 @@ public:
 	virtual UWorld* GetTickableGameObjectWorld() const override;
 	//~End of FTickableObjectBase interface
 
+	/** Returns the reason for the loading screen state, as of the last time it changed or was logged */
 	UFUNCTION(BlueprintCallable, Category=LoadingScreen)
 	FString GetDebugReasonForShowingOrHidingLoadingScreen() const
 	{
 		return DebugReasonForShowingOrHidingLoadingScreen;
 	}
 
+	/** Asks for the need to show the loading screen to be evaluated on the next tick. Loading processors call this when their state changes. */
+	UFUNCTION(BlueprintCallable, Category=LoadingScreen)
+	void MarkLoadingScreenStateDirty();
+
 	/** Returns True when the loading screen is currently being shown */
 	bool GetLoadingScreenDisplayStatus() const
 	{
@@ -61,19 +77,45 @@ public:
 
 	void RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
 	void UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
+
+	/** Returns the phase timestamps of the most recent loading screen transitions */
+	const FLoadingScreenTimelineHistory& GetTimelineHistory() const
+	{
+		return TimelineHistory;
+	}
 	
 private:
 	void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
 	void HandlePostLoadMap(UWorld* World);
-
-	/** Determines if we should show or hide the loading screen. Called every frame. */
+	void HandlePostWorldInitialization(UWorld* World, const FWorldInitializationValues IVS);
+	void HandleWorldBeginPlay();
+	void HandleGameStateSet(AGameStateBase* GameState);
+	void HandleSeamlessTravelStart(UWorld* World, const FString& MapName);
+	void HandleSeamlessTravelTransition(UWorld* World);
+	void HandleLocalPlayerChanged(ULocalPlayer* LocalPlayer);
+	void HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+	void HandleNetworkFailure(UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString);
+
+	/** Returns true if the loading screen state should be evaluated this tick */
+	bool ShouldUpdateLoadingScreen() const;
+
+	/** Determines if we should show or hide the loading screen. Called every frame, or only when dirty in event driven mode. */
 	void UpdateLoadingScreen();
 
-	/** Returns true if we need to be showing the loading screen. */
-	bool CheckForAnyNeedToShowLoadingScreen();
+	/** Returns true if we need to be showing the loading screen. The reason is only built when OutReason is set, OutBlockingProcessor is set to the loading processor that needs it, if any. */
+	bool CheckForAnyNeedToShowLoadingScreen(FString* OutReason, UObject** OutBlockingProcessor = nullptr) const;
 
 	/** Returns true if we want to be showing the loading screen (if we need to or are artificially forcing it on for other reasons). */
-	bool ShouldShowLoadingScreen();
+	bool ShouldShowLoadingScreen(FString* OutReason);
+
+	/** Returns true once nothing is left that a held loading screen should wait for. The reason is only built when OutReason is set. */
+	bool IsReadyToDropLoadingScreen(FString* OutReason) const;
+
+	/** Adds an event to the timeline of the current transition, if one is being recorded */
+	void RecordTimelineEvent(const TCHAR* Phase, FString Detail = FString());
+
+	/** Records loading processors starting and stopping to need the loading screen */
+	void UpdateTimelineBlockingProcessor(UObject* BlockingProcessor);
 
 	/** Returns true if we are in the initial loading flow before this screen should be used */
 	bool IsShowingInitialLoadingScreen() const;
@@ -84,6 +126,12 @@ private:
 	/** Hides the loading screen. The loading screen widget will be destroyed */
 	void HideLoadingScreen();
 
+	/** Collects garbage once the loading screen is only being held, then purges it within the frame budget. Reachability analysis is not budgeted. */
+	void UpdateGarbageCollectionWhileHeld();
+
+	/** Returns true if garbage was collected since the load was done, recently enough that dropping the loading screen does not need to */
+	bool HasCollectedGarbageRecently() const;
+
 	/** Removes the widget from the viewport */
 	void RemoveWidgetFromViewport();
 
@@ -121,6 +169,9 @@ private:
 	/** The time the loading screen most recently wanted to be dismissed (might still be up due to a min display duration requirement) **/
 	double TimeLoadingScreenLastDismissed = -1.0;
 
+	/** The frame the loading screen most recently wanted to be dismissed */
+	uint64 FrameLoadingScreenLastDismissed = 0;
+
 	/** The time until the next log for why the loading screen is still up */
 	double TimeUntilNextLogHeartbeatSeconds = 0.0;
 
@@ -129,4 +180,27 @@ private:
 
 	/** True when the loading screen is currently being shown */
 	bool bCurrentlyShowingLoadingScreen = false;
+
+	/** True when something changed that may change the need for the loading screen */
+	bool bLoadingScreenStateDirty = true;
+
+	/** True once garbage collection has been started for the current loading screen */
+	bool bStartedLoadingScreenGarbageCollection = false;
+
+	/** Time spent purging garbage while the loading screen was held, and over how many frames */
+	double LoadingScreenPurgeSeconds = 0.0;
+	int32 LoadingScreenPurgeFrames = 0;
+
+	/** The time until the loading screen state is evaluated even though nothing marked it dirty */
+	double TimeUntilNextFallbackUpdateSeconds = 0.0;
+
+	/** Phase timestamps of the current and most recent loading screen transitions */
+	FLoadingScreenTimelineHistory TimelineHistory;
+
+	/** The loading processor that needed the loading screen the last time it was evaluated */
+	TWeakObjectPtr<UObject> TimelineBlockingProcessor;
+	FString TimelineBlockingProcessorName;
+
+	/** Why the hold of the loading screen ended, recorded when it is hidden */
+	const TCHAR* HoldEndReason = TEXT("");
 };
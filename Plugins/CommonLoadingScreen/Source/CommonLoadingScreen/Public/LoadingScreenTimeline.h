@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Misc/DateTime.h"
+
+class FOutputDevice;
+
+/** A phase of a loading screen transition, e.g. PostLoadMap or a loading processor letting go of the screen */
+struct FLoadingScreenTimelineEvent
+{
+	/** What happened */
+	FString Phase;
+
+	/** Extra information about the phase, e.g. the processor or the map */
+	FString Detail;
+
+	/** Seconds since the transition started */
+	double Seconds = 0.0;
+
+	/** Frames since the transition started */
+	uint64 Frames = 0;
+};
+
+/** The phases of one loading screen transition, from the first thing that needed a loading screen until it was hidden */
+struct FLoadingScreenTimeline
+{
+	/** The map being loaded, if any */
+	FString MapName;
+
+	/** When the transition started */
+	FDateTime StartDateTime;
+	double StartTime = 0.0;
+	uint64 StartFrame = 0;
+
+	/** How long the transition took, set once it ended */
+	double DurationSeconds = 0.0;
+	uint64 DurationFrames = 0;
+
+	TArray<FLoadingScreenTimelineEvent> Events;
+};
+
+/**
+ * Records the phase timestamps of loading screen transitions, keeping the most recent ones in a ring buffer.
+ * Events are only recorded while a transition is in progress.
+ */
+class COMMONLOADINGSCREEN_API FLoadingScreenTimelineHistory
+{
+public:
+	/** Starts a new transition, dropping an unfinished one */
+	void BeginTimeline(const FString& MapName);
+
+	/** Sets the map of the transition in progress */
+	void SetMapName(const FString& MapName);
+
+	/** Adds an event to the transition in progress */
+	void AddEvent(const TCHAR* Phase, FString Detail = FString());
+
+	/** Ends the transition in progress and stores it, the oldest stored transition makes room if there are MaxTimelines */
+	void EndTimeline(int32 MaxTimelines);
+
+	/** Returns true while a transition is in progress */
+	bool IsRecording() const
+	{
+		return bRecording;
+	}
+
+	/** Returns the stored transitions, oldest first */
+	TArray<const FLoadingScreenTimeline*> GetTimelines() const;
+
+	/** Prints the last NumTimelines stored transitions, with the time each phase took */
+	void Dump(FOutputDevice& Ar, int32 NumTimelines) const;
+
+	/** Writes all stored transitions to a CSV file, one row per event. Returns false if the file could not be written. */
+	bool ExportCSV(const FString& Filename) const;
+
+private:
+	/** The transition in progress */
+	FLoadingScreenTimeline CurrentTimeline;
+	bool bRecording = false;
+
+	/** The stored transitions, NextTimelineIndex is where the next one goes once the buffer is full */
+	TArray<FLoadingScreenTimeline> Timelines;
+	int32 NextTimelineIndex = 0;
+};
@@ -4,22 +4,79 @@
 
 #include "AudioDevice.h"
 #include "Components/AudioComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Engine/WorldInitializationValues.h"
 #include "Game/RogueGameInstance.h"
 #include "Game/RogueGameState.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "LoadingScreenManager.h"
 #include "PlatformFeatures.h"
 #include "Settings/RogueDeveloperSettings.h"
 #include "Settings/RogueGameUserSettings.h"
+#include "Settings/RogueSettingsPersistenceSubsystem.h"
 #include "Settings/RogueWorldSettings.h"
+#include "Sound/SoundWave.h"
 
+#include "Camera/RogueCameraSubsystem.h"
 #include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
 
 DEFINE_LOG_CATEGORY(LogRogueAudioSubsystem);
 
+DECLARE_STATS_GROUP(TEXT("RogueAudio"), STATGROUP_RogueAudio, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SFX Voices Active"), STAT_RogueSFXVoicesActive, STATGROUP_RogueAudio);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SFX Voices Pooled"), STAT_RogueSFXVoicesPooled, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SFX Played"), STAT_RogueSFXPlayed, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SFX Voices Stolen"), STAT_RogueSFXStolen, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SFX Culled"), STAT_RogueSFXCulled, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SFX Rejected"), STAT_RogueSFXRejected, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Volume Changes"), STAT_RogueAudioVolumeChanges, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mix Flushes"), STAT_RogueAudioMixFlushes, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mix Class Overrides"), STAT_RogueAudioMixOverrides, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mix Pushes"), STAT_RogueAudioMixPushes, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Level State Changes"), STAT_RogueAudioLevelStateChanges, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Music Switches"), STAT_RogueAudioMusicSwitches, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Events Posted"), STAT_RogueAudioEventsPosted, STATGROUP_RogueAudio);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Settings Saves"), STAT_RogueAudioSettingsSaves, STATGROUP_RogueAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Asset Load Ms"), STAT_RogueAudioAssetLoadMs, STATGROUP_RogueAudio);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Asset Load Blocked Ms"), STAT_RogueAudioAssetLoadBlockedMs, STATGROUP_RogueAudio);
+
+DECLARE_CYCLE_STAT(TEXT("Initialize"), STAT_RogueAudio_Initialize, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Audio Assets Loaded"), STAT_RogueAudio_AssetsLoaded, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("World Begin Play"), STAT_RogueAudio_WorldBeginPlay, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Save Audio Settings"), STAT_RogueAudio_SaveSettings, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Set Volume"), STAT_RogueAudio_SetVolume, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Flush Mix Changes"), STAT_RogueAudio_FlushMix, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Game State Changed"), STAT_RogueAudio_GameStateChanged, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Apply Snapshot"), STAT_RogueAudio_ApplySnapshot, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Transition To Music"), STAT_RogueAudio_TransitionToMusic, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Switch Music Deck"), STAT_RogueAudio_SwitchMusicDeck, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Play SFX"), STAT_RogueAudio_PlaySFX, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Post Audio Event"), STAT_RogueAudio_PostAudioEvent, STATGROUP_RogueAudio);
+DECLARE_CYCLE_STAT(TEXT("Set World Music Suspended"), STAT_RogueAudio_SetWorldMusicSuspended, STATGROUP_RogueAudio);
+
+namespace RogueAudioCommands
+{
+    static FAutoConsoleCommandWithWorldAndArgs Benchmark(
+        TEXT("Rogue.Audio.Benchmark"),
+        TEXT("Runs rapid level state and volume changes through the audio subsystem and logs the cost of each operation. Usage: Rogue.Audio.Benchmark [Iterations=200]. Run with -nosound to measure against the null audio device."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+            if (URogueAudioSubsystem* AudioSubsystem = GameInstance ? GameInstance->GetSubsystem<URogueAudioSubsystem>() : nullptr)
+            {
+                AudioSubsystem->RunAudioBenchmark(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200);
+            }
+        }));
+}
+
 void URogueAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_Initialize);
+
     Super::Initialize(Collection);
 
     // Ask the loading screen to notify us when its visibility changes
@@ -35,11 +92,13 @@ void URogueAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     // Load default audio classes from the Rogue Developer Project Settings
     // Note that we're using IsNull here to check if the soft object pointer path is null
     // IsValid, checks an already loaded object
+    // Everything is requested in a single async batch so game instance startup does not block on audio
+    TArray<FSoftObjectPath> AudioAssetPaths;
 
     // Default Sound Mixer
     if (!CurrentDeveloperSettings->DefaultSoundMixModifier.IsNull())
     {
-        DefaultSoundMixModifier = CurrentDeveloperSettings->DefaultSoundMixModifier.LoadSynchronous();
+        AudioAssetPaths.Add(CurrentDeveloperSettings->DefaultSoundMixModifier.ToSoftObjectPath());
     }
     else
     {
@@ -49,7 +108,7 @@ void URogueAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     // Main Sound
     if (!CurrentDeveloperSettings->MainSoundClass.IsNull())
     {
-        MainSoundClass = CurrentDeveloperSettings->MainSoundClass.LoadSynchronous();
+        AudioAssetPaths.Add(CurrentDeveloperSettings->MainSoundClass.ToSoftObjectPath());
     }
     else
     {
@@ -59,7 +118,7 @@ void URogueAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     // Music
     if (!CurrentDeveloperSettings->MusicSoundClass.IsNull())
     {
-        MusicSoundClass = CurrentDeveloperSettings->MusicSoundClass.LoadSynchronous();
+        AudioAssetPaths.Add(CurrentDeveloperSettings->MusicSoundClass.ToSoftObjectPath());
     }
     else
     {
@@ -69,7 +128,7 @@ void URogueAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     // SFX
     if (!CurrentDeveloperSettings->SFXSoundClass.IsNull())
     {
-        SFXSoundClass = CurrentDeveloperSettings->SFXSoundClass.LoadSynchronous();
+        AudioAssetPaths.Add(CurrentDeveloperSettings->SFXSoundClass.ToSoftObjectPath());
     }
     else
     {
@@ -79,33 +138,237 @@ void URogueAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     // Load the (optional) default music for the game from the Rogue Developer Project Settings
     if (!CurrentDeveloperSettings->LevelCompleteMusic.IsNull())
     {
-        LevelCompleteMusic = CurrentDeveloperSettings->LevelCompleteMusic.LoadSynchronous();
+        AudioAssetPaths.Add(CurrentDeveloperSettings->LevelCompleteMusic.ToSoftObjectPath());
     }
 
     if (!CurrentDeveloperSettings->LevelFailMusic.IsNull())
     {
-        LevelFailMusic = CurrentDeveloperSettings->LevelFailMusic.LoadSynchronous();
+        AudioAssetPaths.Add(CurrentDeveloperSettings->LevelFailMusic.ToSoftObjectPath());
+    }
+
+    // The (optional) level state snapshots
+    for (const TPair<ELevelState, TSoftObjectPtr<USoundMix>>& Snapshot : CurrentDeveloperSettings->LevelStateSoundMixes)
+    {
+        if (!Snapshot.Value.IsNull())
+        {
+            AudioAssetPaths.Add(Snapshot.Value.ToSoftObjectPath());
+        }
+    }
+
+    // The (optional) audio event table, its sounds are loaded once the table is in
+    if (!CurrentDeveloperSettings->AudioEventTable.IsNull())
+    {
+        AudioAssetPaths.Add(CurrentDeveloperSettings->AudioEventTable.ToSoftObjectPath());
     }
 
+    AudioLoadStartTime = FPlatformTime::Seconds();
+
+    if (AudioAssetPaths.Num() > 0)
+    {
+        AudioAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AudioAssetPaths, FStreamableDelegate::CreateUObject(this, &ThisClass::AudioAssetsLoaded), FStreamableManager::AsyncLoadHighPriority);
+    }
+
+    // The request can complete immediately when everything is already in memory
+    if (!AudioAssetsHandle.IsValid() || AudioAssetsHandle->HasLoadCompleted())
+    {
+        AudioAssetsLoaded();
+    }
+
+    UE_LOG(LogRogueAudioSubsystem, Log, TEXT("URogueAudioSubsystem::Initialize requested %d audio assets in %.2fms."), AudioAssetPaths.Num(), (FPlatformTime::Seconds() - AudioLoadStartTime) * 1000.0);
+
     // Bind to world initialization so that the audio subsystem knows about the world state (BeginPlay)
     PostWorldCreationHandle = FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &URogueAudioSubsystem::WorldInitialization);
 }
 
-void URogueAudioSubsystem::SaveAudioSettings()
+void URogueAudioSubsystem::Deinitialize()
 {
-    if (CurrentGameSettings)
+    FTSTicker::GetCoreTicker().RemoveTicker(MusicTransitionHandle);
+    MusicTransitionHandle.Reset();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(MixFlushTickerHandle);
+    MixFlushTickerHandle.Reset();
+
+    if (AudioAssetsHandle.IsValid())
     {
-        CurrentGameSettings->SaveSettings();
+        AudioAssetsHandle->CancelHandle();
+        AudioAssetsHandle.Reset();
     }
-    else
+
+    if (AudioEventSoundsHandle.IsValid())
+    {
+        AudioEventSoundsHandle->CancelHandle();
+        AudioEventSoundsHandle.Reset();
+    }
+
+    Super::Deinitialize();
+}
+
+void URogueAudioSubsystem::AudioAssetsLoaded()
+{
+    if (bAudioAssetsLoaded)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_AssetsLoaded);
+
+    bAudioAssetsLoaded = true;
+
+    // The soft pointers resolve to the loaded assets, hold them with hard references from here on
+    DefaultSoundMixModifier = CurrentDeveloperSettings->DefaultSoundMixModifier.Get();
+    MainSoundClass          = CurrentDeveloperSettings->MainSoundClass.Get();
+    MusicSoundClass         = CurrentDeveloperSettings->MusicSoundClass.Get();
+    SFXSoundClass           = CurrentDeveloperSettings->SFXSoundClass.Get();
+    LevelCompleteMusic      = CurrentDeveloperSettings->LevelCompleteMusic.Get();
+    LevelFailMusic          = CurrentDeveloperSettings->LevelFailMusic.Get();
+
+    // Stingers start the moment the level ends, their first chunks have to be resident by then
+    for (USoundBase* Stinger : {LevelCompleteMusic.Get(), LevelFailMusic.Get()})
+    {
+        if (IsValid(Stinger))
+        {
+            UGameplayStatics::PrimeSound(Stinger);
+        }
+    }
+
+    for (const TPair<ELevelState, TSoftObjectPtr<USoundMix>>& Snapshot : CurrentDeveloperSettings->LevelStateSoundMixes)
+    {
+        if (USoundMix* SnapshotMix = Snapshot.Value.Get())
+        {
+            LevelStateSoundMixes.Add(Snapshot.Key, SnapshotMix);
+        }
+    }
+
+    // Loading in the background saves everything but the time spent waiting on it in WorldBeginPlay
+    const double Now       = FPlatformTime::Seconds();
+    const double LoadMs    = (Now - AudioLoadStartTime) * 1000.0;
+    const double BlockedMs = AudioLoadWaitStartTime > 0.0 ? (Now - AudioLoadWaitStartTime) * 1000.0 : 0.0;
+    UE_LOG(LogRogueAudioSubsystem, Log, TEXT("URogueAudioSubsystem audio assets loaded after %.2fms, game thread blocked for %.2fms (%.2fms saved)."), LoadMs, BlockedMs, LoadMs - BlockedMs);
+    SET_FLOAT_STAT(STAT_RogueAudioAssetLoadMs, LoadMs);
+    SET_FLOAT_STAT(STAT_RogueAudioAssetLoadBlockedMs, BlockedMs);
+
+    AudioAssetsHandle.Reset();
+
+    BuildAudioEventRoutes();
+
+    // Apply whatever was deferred while loading
+    if (IsValid(CurrentGameSettings))
+    {
+        UpdateMixersFromAudioData();
+    }
+
+    if (bWorldMusicDeferred)
+    {
+        bWorldMusicDeferred = false;
+        StartDefaultWorldMusic();
+    }
+}
+
+void URogueAudioSubsystem::BuildAudioEventRoutes()
+{
+    const UDataTable* EventTable = CurrentDeveloperSettings->AudioEventTable.Get();
+    if (!EventTable)
+    {
+        return;
+    }
+
+    TArray<FSoftObjectPath> SoundPaths;
+
+    EventTable->ForeachRow<FRogueAudioEventRow>(TEXT("URogueAudioSubsystem::BuildAudioEventRoutes"), [this, &SoundPaths](const FName& RowName, const FRogueAudioEventRow& Row)
+    {
+        if (!Row.EventTag.IsValid())
+        {
+            UE_LOG(LogRogueAudioSubsystem, Warning, TEXT("URogueAudioSubsystem::BuildAudioEventRoutes row %s has no event tag."), *RowName.ToString());
+            return;
+        }
+
+        if (AudioEventRoutes.Contains(Row.EventTag))
+        {
+            UE_LOG(LogRogueAudioSubsystem, Warning, TEXT("URogueAudioSubsystem::BuildAudioEventRoutes row %s maps %s again, ignoring it."), *RowName.ToString(), *Row.EventTag.ToString());
+            return;
+        }
+
+        FRogueAudioEventRoute& Route = AudioEventRoutes.Add(Row.EventTag);
+        Route.Category               = Row.Category;
+        Route.Priority               = Row.Priority;
+        Route.Cooldown               = Row.Cooldown;
+        Route.VolumeRange            = Row.VolumeRange;
+        Route.PitchRange             = Row.PitchRange;
+        Route.b2D                    = Row.b2D;
+
+        for (const TSoftObjectPtr<USoundBase>& Variation : Row.Variations)
+        {
+            if (!Variation.IsNull())
+            {
+                SoundPaths.AddUnique(Variation.ToSoftObjectPath());
+            }
+        }
+    });
+
+    if (SoundPaths.Num() > 0)
+    {
+        AudioEventSoundsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SoundPaths, FStreamableDelegate::CreateUObject(this, &ThisClass::AudioEventSoundsLoaded));
+    }
+}
+
+void URogueAudioSubsystem::AudioEventSoundsLoaded()
+{
+    AudioEventSoundsHandle.Reset();
+
+    const UDataTable* EventTable = CurrentDeveloperSettings->AudioEventTable.Get();
+    if (!EventTable)
+    {
+        return;
+    }
+
+    // Hold the loaded sounds with hard references so posting an event never touches soft pointers
+    EventTable->ForeachRow<FRogueAudioEventRow>(TEXT("URogueAudioSubsystem::AudioEventSoundsLoaded"), [this](const FName& RowName, const FRogueAudioEventRow& Row)
+    {
+        FRogueAudioEventRoute* Route = AudioEventRoutes.Find(Row.EventTag);
+        if (!Route || Route->Sounds.Num() > 0)
+        {
+            return;
+        }
+
+        for (const TSoftObjectPtr<USoundBase>& Variation : Row.Variations)
+        {
+            if (USoundBase* Sound = Variation.Get())
+            {
+                Route->Sounds.Add(Sound);
+            }
+        }
+    });
+
+    UE_LOG(LogRogueAudioSubsystem, Log, TEXT("URogueAudioSubsystem loaded sounds for %d audio events."), AudioEventRoutes.Num());
+}
+
+void URogueAudioSubsystem::SaveAudioSettings()
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_SaveSettings);
+    INC_DWORD_STAT(STAT_RogueAudioSettingsSaves);
+
+    if (!CurrentGameSettings)
     {
         UE_LOG(LogRogueAudioSubsystem, Error, TEXT("URogueAudioSubsystem::SaveAudioSettings CurrentGameSettings is nullptr."));
         return;
     }
+
+    // Settings screens may call this for every slider change, so the write is debounced and done off the game thread
+    if (URogueSettingsPersistenceSubsystem* Persistence = GetGameInstance()->GetSubsystem<URogueSettingsPersistenceSubsystem>())
+    {
+        Persistence->RequestSaveGameUserSettings();
+    }
+    else
+    {
+        CurrentGameSettings->SaveSettings();
+    }
 }
 
 void URogueAudioSubsystem::SetMainVolume(float NewVolume, float FadeIn)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_SetVolume);
+    INC_DWORD_STAT(STAT_RogueAudioVolumeChanges);
+
     if (CurrentGameSettings)
     {
         CurrentGameSettings->MainVolume = NewVolume;
@@ -121,6 +384,9 @@ void URogueAudioSubsystem::SetMainVolume(float NewVolume, float FadeIn)
 
 void URogueAudioSubsystem::SetMusicVolume(float NewVolume, float FadeIn)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_SetVolume);
+    INC_DWORD_STAT(STAT_RogueAudioVolumeChanges);
+
     if (CurrentGameSettings)
     {
         CurrentGameSettings->MusicVolume = NewVolume;
@@ -136,6 +402,9 @@ void URogueAudioSubsystem::SetMusicVolume(float NewVolume, float FadeIn)
 
 void URogueAudioSubsystem::SetSFXVolume(float NewVolume, float FadeIn)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_SetVolume);
+    INC_DWORD_STAT(STAT_RogueAudioVolumeChanges);
+
     if (CurrentGameSettings)
     {
         CurrentGameSettings->SFXVolume = NewVolume;
@@ -184,7 +453,7 @@ float URogueAudioSubsystem::GetSFXVolume()
 
 bool URogueAudioSubsystem::WorldMusicInitialized()
 {
-    if (!IsValid(WorldMusicPlayer))
+    if (!IsValid(GetActiveMusicDeck()))
     {
         return false;
     }
@@ -199,25 +468,79 @@ void URogueAudioSubsystem::PlaySoundAsWorldMusic(USoundBase* Music)
 
 void URogueAudioSubsystem::ApplyVolumeChangeToMix(USoundClass* TargetSoundClass, float Volume, float FadeIn)
 {
-    // Get the audio device, apply the override to the mix, push modifier update
+    if (!IsValid(TargetSoundClass))
+    {
+        return;
+    }
+
+    // Only the latest change per sound class matters, e.g. while a volume slider is dragged
+    FPendingMixChange& Change = PendingMixChanges.FindOrAdd(TargetSoundClass);
+    Change.Volume             = Volume;
+    Change.FadeIn             = FadeIn;
+
+    // Flush once on the next frame, however many changes come in until then
+    if (!MixFlushTickerHandle.IsValid())
+    {
+        MixFlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::FlushMixChanges));
+    }
+}
+
+bool URogueAudioSubsystem::FlushMixChanges(float DeltaTime)
+{
+    // The stored volumes are applied once the mix has loaded and there is a world to apply them in.
+    // Keep the changes and try again next frame until then.
+    if (!bAudioAssetsLoaded || !IsValid(CurrentWorld))
+    {
+        return true;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_FlushMix);
+    INC_DWORD_STAT(STAT_RogueAudioMixFlushes);
+
+    MixFlushTickerHandle.Reset();
+
+    // Get the audio device, apply the overrides to the mix, push the mix once
     if (FAudioDeviceHandle AudioDevice = CurrentWorld->GetAudioDevice())
     {
-        AudioDevice->SetSoundMixClassOverride(
-            DefaultSoundMixModifier, /* Sound Mix Modifier */
-            TargetSoundClass,        /* Sound Class */
-            Volume,                  /* Volume Multiplier*/
-            1.0f,                    /* Pitch Multiplier */
-            FadeIn,                  /* Fade In Time */
-            true                     /* Apply To Children */
-        );
-        AudioDevice->PushSoundMixModifier(DefaultSoundMixModifier);
+        for (const TPair<USoundClass*, FPendingMixChange>& Change : PendingMixChanges)
+        {
+            AudioDevice->SetSoundMixClassOverride(
+                DefaultSoundMixModifier, /* Sound Mix Modifier */
+                Change.Key,              /* Sound Class */
+                Change.Value.Volume,     /* Volume Multiplier*/
+                1.0f,                    /* Pitch Multiplier */
+                Change.Value.FadeIn,     /* Fade In Time */
+                true                     /* Apply To Children */
+            );
+        }
+
+        INC_DWORD_STAT_BY(STAT_RogueAudioMixOverrides, PendingMixChanges.Num());
+
+        // Overrides on an active mix take effect immediately. Pushing again would only add another reference to the mix.
+        // Each device has its own mix stack, e.g. the per player devices of PIE.
+        bool bAlreadyPushed = false;
+        DefaultMixPushedDeviceIds.Add(AudioDevice.GetDeviceID(), &bAlreadyPushed);
+        if (!bAlreadyPushed)
+        {
+            AudioDevice->PushSoundMixModifier(DefaultSoundMixModifier);
+            INC_DWORD_STAT(STAT_RogueAudioMixPushes);
+        }
     }
+
+    PendingMixChanges.Reset();
+    return false;
 }
 
 void URogueAudioSubsystem::WorldInitialization(UWorld* World, const FWorldInitializationValues IVS)
 {
     if (World)
     {
+        // Pooled voices live in the previous world
+        ReleaseSFXVoices();
+
+        // The new world may come with a new audio device or a cleared mix stack, push the default mix again on the next flush
+        DefaultMixPushedDeviceIds.Reset();
+
         // The world has been initialized so now we can bind to BeginPlay of the world.
         // Here, we bind our world begin play function to this delegate.
         CurrentWorld           = World;
@@ -231,17 +554,43 @@ void URogueAudioSubsystem::WorldInitialization(UWorld* World, const FWorldInitia
             UE_LOG(LogRogueAudioSubsystem, Error, TEXT("URogueAudioSubsystem::WorldInitialization unable to get Rogue world settings. Check world %s"), *CurrentWorld->GetName());
             return;
         }
+
+        // The world music starts once the loading screen drops, stream in its first chunks behind the loading screen
+        if (IsValid(CurrentWorldSettings->WorldMusic))
+        {
+            UGameplayStatics::PrimeSound(CurrentWorldSettings->WorldMusic);
+        }
     }
 }
 
 void URogueAudioSubsystem::WorldBeginPlay()
 {
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_WorldBeginPlay);
+
+    // The world needs the mixer and music, finish the audio bootstrap if it is still in flight
+    if (!bAudioAssetsLoaded && AudioAssetsHandle.IsValid())
+    {
+        // Keep the handle alive locally, the completion callback releases the member
+        const TSharedPtr<FStreamableHandle> Handle = AudioAssetsHandle;
+
+        AudioLoadWaitStartTime = FPlatformTime::Seconds();
+        Handle->WaitUntilComplete();
+
+        AudioAssetsLoaded();
+    }
+
     // Get the game user settings
     CurrentGameSettings = GetRogueGameSettings();
 
     // Apply sound settings to world audio device
     UpdateMixersFromAudioData();
 
+    // A pause of the previous level does not carry over
+    bWorldMusicPausedByGame = false;
+
+    // Neither does the snapshot, the mix modifiers live on the audio device and outlast the world
+    ApplyLevelStateSnapshot(nullptr);
+
     // Optionally bind to Rogue game state so the subsystem is informed of state events
     if ((RogueGameState = CurrentWorld->GetGameState<ARogueGameState>()))
     {
@@ -264,15 +613,14 @@ void URogueAudioSubsystem::LoadingScreenVisibilityChanged(bool bVisible)
     if (!bVisible)
     {
         // Now that the loading screen is no longer visible, play the world music
+        bWorldMusicPausedForLoading = false;
         StartDefaultWorldMusic();
     }
     else
     {
-        // When a loading screen has popped up, stop any world music
-        if (IsValid(WorldMusicPlayer))
-        {
-            WorldMusicPlayer->Stop();
-        }
+        // When a loading screen has popped up, hold the world music where it is
+        bWorldMusicPausedForLoading = true;
+        UpdateWorldMusicPaused();
     }
 }
 
@@ -280,7 +628,7 @@ void URogueAudioSubsystem::UpdateMixersFromAudioData()
 {
     if (IsValid(CurrentGameSettings))
     {
-        // Apply audio data settings to mixer
+        // Apply audio data settings to mixer, flushed together on the next frame
         ApplyVolumeChangeToMix(MainSoundClass, CurrentGameSettings->MainVolume, 0.0f);
         ApplyVolumeChangeToMix(MusicSoundClass, CurrentGameSettings->MusicVolume, 0.0f);
         ApplyVolumeChangeToMix(SFXSoundClass, CurrentGameSettings->SFXVolume, 0.0f);
@@ -289,9 +637,15 @@ void URogueAudioSubsystem::UpdateMixersFromAudioData()
 
 void URogueAudioSubsystem::GameStateChanged(ELevelState NewLevelState)
 {
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_GameStateChanged);
+    INC_DWORD_STAT(STAT_RogueAudioLevelStateChanges);
+
+    ApplyLevelStateSnapshot(LevelStateSoundMixes.FindRef(NewLevelState));
+
     if (NewLevelState == ELevelState::Paused || NewLevelState == ELevelState::Running)
     {
-        TogglePauseWorldMusic();
+        bWorldMusicPausedByGame = NewLevelState == ELevelState::Paused;
+        UpdateWorldMusicPaused();
         return;
     }
 
@@ -308,8 +662,42 @@ void URogueAudioSubsystem::GameStateChanged(ELevelState NewLevelState)
     }
 }
 
+void URogueAudioSubsystem::ApplyLevelStateSnapshot(USoundMix* Snapshot)
+{
+    if (Snapshot == ActiveLevelStateSoundMix || !IsValid(CurrentWorld))
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_ApplySnapshot);
+
+    if (FAudioDeviceHandle AudioDevice = CurrentWorld->GetAudioDevice())
+    {
+        // A single pop and push whatever the snapshots adjust, each mix fades with its own fade in and out times
+        if (ActiveLevelStateSoundMix)
+        {
+            AudioDevice->PopSoundMixModifier(ActiveLevelStateSoundMix);
+        }
+
+        if (Snapshot)
+        {
+            AudioDevice->PushSoundMixModifier(Snapshot);
+            INC_DWORD_STAT(STAT_RogueAudioMixPushes);
+        }
+    }
+
+    ActiveLevelStateSoundMix = Snapshot;
+}
+
 void URogueAudioSubsystem::StartDefaultWorldMusic()
 {
+    // The music volume depends on the sound classes, start once they have loaded
+    if (!bAudioAssetsLoaded)
+    {
+        bWorldMusicDeferred = true;
+        return;
+    }
+
     if (!IsValid(CurrentWorld))
     {
         UE_LOG(LogRogueAudioSubsystem, Error, TEXT("URogueAudioSubsystem::StartDefaultWorldMusic CurrentWorld is null"));
@@ -339,10 +727,80 @@ void URogueAudioSubsystem::PlayWorldMusic(USoundBase* Music)
         return;
     }
 
-    if (!IsValid(WorldMusicPlayer))
+    TransitionToMusic(Music, false);
+}
+
+void URogueAudioSubsystem::TransitionToMusic(USoundBase* Music, bool bAlignToBar)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_TransitionToMusic);
+
+    // Returning to the music that is already loaded on the deck, e.g. after a loading screen, continues where it was
+    const UAudioComponent* ActiveDeck = GetActiveMusicDeck();
+    if (IsValid(ActiveDeck) && ActiveDeck->Sound == Music && ActiveDeck->IsPlaying() && !PendingMusic)
+    {
+        UpdateWorldMusicPaused();
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(MusicTransitionHandle);
+    MusicTransitionHandle.Reset();
+
+    PendingMusic = Music;
+
+    const float Delay = bAlignToBar ? GetTimeToNextBar() : 0.0f;
+    if (Delay > 0.0f)
+    {
+        // Start streaming in the first chunks of the next track while the current one plays out to the bar.
+        // Tracks known ahead of time are primed when they become known, see WorldInitialization and AudioAssetsLoaded.
+        UGameplayStatics::PrimeSound(Music);
+        MusicTransitionHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::SwitchMusicDeck), Delay);
+    }
+    else
+    {
+        SwitchMusicDeck(0.0f);
+    }
+}
+
+bool URogueAudioSubsystem::SwitchMusicDeck(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_SwitchMusicDeck);
+
+    MusicTransitionHandle.Reset();
+
+    USoundBase* Music = PendingMusic;
+    PendingMusic      = nullptr;
+
+    if (!IsValid(Music) || !IsValid(CurrentWorld))
+    {
+        return false;
+    }
+
+    const float CrossfadeSeconds = CurrentDeveloperSettings->MusicCrossfadeSeconds;
+
+    UAudioComponent* OutgoingDeck = GetActiveMusicDeck();
+    const bool bCrossfade         = IsValid(OutgoingDeck) && OutgoingDeck->IsPlaying() && !OutgoingDeck->bIsPaused;
+    if (IsValid(OutgoingDeck))
+    {
+        if (bCrossfade)
+        {
+            OutgoingDeck->FadeOut(CrossfadeSeconds, 0.0f);
+        }
+        else
+        {
+            OutgoingDeck->Stop();
+        }
+    }
+
+    INC_DWORD_STAT(STAT_RogueAudioMusicSwitches);
+
+    ActiveMusicDeck     = 1 - ActiveMusicDeck;
+    ActiveMusicPosition = 0.0f;
+
+    TObjectPtr<UAudioComponent>& IncomingDeck = MusicDecks[ActiveMusicDeck];
+    if (!IsValid(IncomingDeck))
     {
         // Spawn our audio component
-        WorldMusicPlayer = UGameplayStatics::CreateSound2D(
+        IncomingDeck = UGameplayStatics::CreateSound2D(
             CurrentWorld, /* World Object */
             Music,        /* USoundBase* */
             1.0f,         /* Volume Multiplier */
@@ -352,6 +810,13 @@ void URogueAudioSubsystem::PlayWorldMusic(USoundBase* Music)
             true,         /* Persist across level transition */
             false);       /* Auto Destroy */
 
+        if (!IncomingDeck)
+        {
+            return false;
+        }
+
+        IncomingDeck->OnAudioPlaybackPercentNative.AddUObject(this, &ThisClass::MusicPlaybackPercent);
+
         if (CurrentGameSettings)
         {
             // Note that the reason we don't set the multiplier directly on the audio component is because
@@ -360,72 +825,467 @@ void URogueAudioSubsystem::PlayWorldMusic(USoundBase* Music)
         }
     }
 
-    if (WorldMusicPlayer->bIsPaused)
+    if (IncomingDeck->bIsPaused)
+    {
+        IncomingDeck->SetPaused(false);
+    }
+
+    // Switch the sound and play it from the beginning, fading in over the outgoing deck
+    IncomingDeck->SetSound(Music);
+    IncomingDeck->FadeIn(bCrossfade ? CrossfadeSeconds : 0.0f, 1.0f, 0.0f);
+
+    // Music started while suspended stays silent until it is resumed
+    UpdateWorldMusicPaused();
+    return false;
+}
+
+void URogueAudioSubsystem::FadeOutMusic()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(MusicTransitionHandle);
+    MusicTransitionHandle.Reset();
+    PendingMusic = nullptr;
+
+    if (UAudioComponent* ActiveDeck = GetActiveMusicDeck())
+    {
+        ActiveDeck->FadeOut(CurrentDeveloperSettings->MusicCrossfadeSeconds, 0.0f);
+    }
+}
+
+float URogueAudioSubsystem::GetTimeToNextBar() const
+{
+    const UAudioComponent* ActiveDeck = GetActiveMusicDeck();
+    if (!IsValid(ActiveDeck) || !ActiveDeck->IsPlaying() || ActiveDeck->bIsPaused || !IsValid(CurrentWorldSettings))
+    {
+        return 0.0f;
+    }
+
+    const float BPM = CurrentWorldSettings->WorldMusicBPM;
+    if (BPM <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    const float BarSeconds = 60.0f / BPM * FMath::Max(CurrentWorldSettings->WorldMusicBeatsPerBar, 1);
+    return BarSeconds - FMath::Fmod(ActiveMusicPosition, BarSeconds);
+}
+
+void URogueAudioSubsystem::MusicPlaybackPercent(const UAudioComponent* Component, const USoundWave* Wave, float Percent)
+{
+    if (Component == GetActiveMusicDeck() && Wave)
+    {
+        ActiveMusicPosition = Percent * Wave->Duration;
+    }
+}
+
+UAudioComponent* URogueAudioSubsystem::PlaySFXAtLocation(USoundBase* Sound, FVector Location, ERogueSfxCategory Category, int32 Priority, float VolumeMultiplier, float PitchMultiplier)
+{
+    return PlaySFX(Sound, &Location, Category, Priority, VolumeMultiplier, PitchMultiplier);
+}
+
+UAudioComponent* URogueAudioSubsystem::PlaySFX2D(USoundBase* Sound, ERogueSfxCategory Category, int32 Priority, float VolumeMultiplier, float PitchMultiplier)
+{
+    return PlaySFX(Sound, nullptr, Category, Priority, VolumeMultiplier, PitchMultiplier);
+}
+
+UAudioComponent* URogueAudioSubsystem::PlaySFX(USoundBase* Sound, const FVector* Location, ERogueSfxCategory Category, int32 Priority, float VolumeMultiplier, float PitchMultiplier)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_PlaySFX);
+
+    if (!IsValid(Sound) || !IsValid(CurrentWorld))
+    {
+        return nullptr;
+    }
+
+    if (Location && IsSFXCulled(*Location))
+    {
+        INC_DWORD_STAT(STAT_RogueSFXCulled);
+        return nullptr;
+    }
+
+    const int32 VoiceIndex = AcquireSFXVoice(Category, Priority);
+    if (VoiceIndex == INDEX_NONE)
+    {
+        INC_DWORD_STAT(STAT_RogueSFXRejected);
+        return nullptr;
+    }
+
+    FRogueSfxVoice& Voice = SFXVoices[VoiceIndex];
+
+    if (!IsValid(Voice.Component))
+    {
+        // The component is owned by the world and reused until the world goes away
+        FAudioDevice::FCreateComponentParams Params(CurrentWorld);
+        Params.bAutoDestroy = false;
+        if (Location)
+        {
+            Params.SetLocation(*Location);
+        }
+
+        Voice.Component = FAudioDevice::CreateComponent(Sound, Params);
+        if (!Voice.Component)
+        {
+            return nullptr;
+        }
+
+        Voice.Component->OnAudioFinishedNative.AddUObject(this, &ThisClass::SFXVoiceFinished);
+        INC_DWORD_STAT(STAT_RogueSFXVoicesPooled);
+    }
+
+    UAudioComponent* Component = Voice.Component;
+    Component->SetSound(Sound);
+    Component->SetVolumeMultiplier(VolumeMultiplier);
+    Component->SetPitchMultiplier(PitchMultiplier);
+    Component->bAllowSpatialization = Location != nullptr;
+    Component->bIsUISound           = Category == ERogueSfxCategory::UI;
+    if (Location)
+    {
+        Component->SetWorldLocation(*Location);
+    }
+
+    Voice.Category = Category;
+    Voice.Priority = Priority;
+    Voice.Serial   = NextSFXSerial++;
+    Voice.bActive  = true;
+
+    ++NumActiveSFXVoices;
+    SET_DWORD_STAT(STAT_RogueSFXVoicesActive, NumActiveSFXVoices);
+    INC_DWORD_STAT(STAT_RogueSFXPlayed);
+
+    Component->Play();
+    return Component;
+}
+
+bool URogueAudioSubsystem::IsSFXCulled(const FVector& Location)
+{
+    URogueCameraSubsystem* CameraSubsystem = CurrentWorld->GetSubsystem<URogueCameraSubsystem>();
+    if (!CameraSubsystem)
+    {
+        return false;
+    }
+
+    const FVector CameraLocation = CameraSubsystem->GetCameraWorldPosition();
+    const float CullDistance     = CurrentDeveloperSettings->SfxCullDistance;
+    if (CullDistance > 0.0f && FVector::DistSquared(CameraLocation, Location) > FMath::Square(CullDistance))
+    {
+        return true;
+    }
+
+    const float Margin = CurrentDeveloperSettings->SfxOffscreenCullMargin;
+    if (Margin < 0.0f)
+    {
+        return false;
+    }
+
+    const APlayerController* PlayerController = CurrentWorld->GetFirstPlayerController();
+    if (!PlayerController)
+    {
+        return false;
+    }
+
+    int32 ViewportX = 0;
+    int32 ViewportY = 0;
+    PlayerController->GetViewportSize(ViewportX, ViewportY);
+
+    FVector2D ScreenPosition;
+    if (ViewportX <= 0 || ViewportY <= 0 || !PlayerController->ProjectWorldLocationToScreen(Location, ScreenPosition))
+    {
+        return false;
+    }
+
+    const float MarginX = ViewportX * Margin;
+    const float MarginY = ViewportY * Margin;
+    return ScreenPosition.X < -MarginX || ScreenPosition.X > ViewportX + MarginX || ScreenPosition.Y < -MarginY || ScreenPosition.Y > ViewportY + MarginY;
+}
+
+int32 URogueAudioSubsystem::AcquireSFXVoice(ERogueSfxCategory Category, int32 Priority)
+{
+    // A full category can only make room within itself
+    const int32 CategoryLimit = CurrentDeveloperSettings->SfxCategoryVoiceLimits.FindRef(Category);
+    if (CategoryLimit > 0)
+    {
+        int32 NumInCategory = 0;
+        for (const FRogueSfxVoice& Voice : SFXVoices)
+        {
+            NumInCategory += (Voice.bActive && Voice.Category == Category) ? 1 : 0;
+        }
+
+        if (NumInCategory >= CategoryLimit)
+        {
+            return StealSFXVoice(&Category, Priority);
+        }
+    }
+
+    for (int32 VoiceIndex = 0; VoiceIndex < SFXVoices.Num(); ++VoiceIndex)
     {
-        WorldMusicPlayer->SetPaused(false);
+        if (!SFXVoices[VoiceIndex].bActive)
+        {
+            return VoiceIndex;
+        }
     }
 
-    if (WorldMusicPlayer->IsPlaying())
+    if (SFXVoices.Num() < CurrentDeveloperSettings->SfxVoiceBudget)
     {
-        WorldMusicPlayer->Stop();
+        return SFXVoices.AddDefaulted();
     }
 
-    // Switch the sound
-    WorldMusicPlayer->Sound = Music;
+    return StealSFXVoice(nullptr, Priority);
+}
+
+int32 URogueAudioSubsystem::StealSFXVoice(const ERogueSfxCategory* Category, int32 Priority)
+{
+    int32 VictimIndex = INDEX_NONE;
+    for (int32 VoiceIndex = 0; VoiceIndex < SFXVoices.Num(); ++VoiceIndex)
+    {
+        const FRogueSfxVoice& Voice = SFXVoices[VoiceIndex];
+        if (!Voice.bActive || Voice.Priority > Priority || (Category && Voice.Category != *Category))
+        {
+            continue;
+        }
+
+        // Lowest priority first, then the oldest sound
+        if (VictimIndex == INDEX_NONE)
+        {
+            VictimIndex = VoiceIndex;
+            continue;
+        }
+
+        const FRogueSfxVoice& Victim = SFXVoices[VictimIndex];
+        if (Voice.Priority < Victim.Priority || (Voice.Priority == Victim.Priority && Voice.Serial < Victim.Serial))
+        {
+            VictimIndex = VoiceIndex;
+        }
+    }
+
+    if (VictimIndex != INDEX_NONE)
+    {
+        FRogueSfxVoice& Victim = SFXVoices[VictimIndex];
+        Victim.bActive         = false;
+        --NumActiveSFXVoices;
+
+        if (IsValid(Victim.Component))
+        {
+            Victim.Component->Stop();
+        }
+
+        INC_DWORD_STAT(STAT_RogueSFXStolen);
+    }
 
-    // Play the music from the beginning
-    WorldMusicPlayer->Play();
+    return VictimIndex;
 }
 
-void URogueAudioSubsystem::TogglePauseWorldMusic()
+void URogueAudioSubsystem::SFXVoiceFinished(UAudioComponent* Component)
 {
-    if (!IsValid(WorldMusicPlayer))
+    // A stolen voice reports finishing after it was restarted, it is still in use then
+    if (!IsValid(Component) || Component->IsPlaying())
     {
         return;
     }
 
-    // Toggle pause of the music player
-    WorldMusicPlayer->SetPaused(!WorldMusicPlayer->bIsPaused);
+    for (FRogueSfxVoice& Voice : SFXVoices)
+    {
+        if (Voice.Component == Component && Voice.bActive)
+        {
+            Voice.bActive = false;
+            --NumActiveSFXVoices;
+            SET_DWORD_STAT(STAT_RogueSFXVoicesActive, NumActiveSFXVoices);
+            break;
+        }
+    }
 }
 
-void URogueAudioSubsystem::StartVictoryMusic()
+void URogueAudioSubsystem::ReleaseSFXVoices()
 {
-    if (!IsValid(WorldMusicPlayer))
+    for (const FRogueSfxVoice& Voice : SFXVoices)
+    {
+        if (IsValid(Voice.Component))
+        {
+            Voice.Component->OnAudioFinishedNative.RemoveAll(this);
+            Voice.Component->Stop();
+        }
+    }
+
+    SFXVoices.Reset();
+    NumActiveSFXVoices = 0;
+
+    SET_DWORD_STAT(STAT_RogueSFXVoicesActive, 0);
+    SET_DWORD_STAT(STAT_RogueSFXVoicesPooled, 0);
+}
+
+void URogueAudioSubsystem::PostAudioEvent(FGameplayTag EventTag, FVector Location)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_PostAudioEvent);
+    INC_DWORD_STAT(STAT_RogueAudioEventsPosted);
+
+    FRogueAudioEventRoute* Route = AudioEventRoutes.Find(EventTag);
+    if (!Route || Route->Sounds.Num() == 0)
     {
         return;
     }
 
-    WorldMusicPlayer->Stop();
+    // Several characters hit by the same attack post the same event in one frame, play it once
+    if (Route->LastPlayFrame == GFrameCounter)
+    {
+        return;
+    }
 
-    if (!IsValid(LevelCompleteMusic))
+    const double Now = FApp::GetCurrentTime();
+    if (Now - Route->LastPlayTime < Route->Cooldown)
     {
-        // No music found so we'll just stop the music player and return
         return;
     }
 
-    // Set the new sound and play
-    WorldMusicPlayer->SetSound(LevelCompleteMusic);
-    WorldMusicPlayer->Play();
+    // Avoid repeating the previous variation when there is a choice
+    int32 Variation = FMath::RandHelper(Route->Sounds.Num());
+    if (Variation == Route->LastVariation && Route->Sounds.Num() > 1)
+    {
+        Variation = (Variation + 1) % Route->Sounds.Num();
+    }
+
+    const float Volume = FMath::FRandRange(Route->VolumeRange.X, Route->VolumeRange.Y);
+    const float Pitch  = FMath::FRandRange(Route->PitchRange.X, Route->PitchRange.Y);
+
+    const UAudioComponent* Voice = Route->b2D
+        ? PlaySFX2D(Route->Sounds[Variation], Route->Category, Route->Priority, Volume, Pitch)
+        : PlaySFXAtLocation(Route->Sounds[Variation], Location, Route->Category, Route->Priority, Volume, Pitch);
+
+    // Culled or rejected posts do not start the cooldown
+    if (Voice)
+    {
+        Route->LastPlayFrame = GFrameCounter;
+        Route->LastPlayTime  = Now;
+        Route->LastVariation = Variation;
+    }
+}
+
+void URogueAudioSubsystem::SetWorldMusicSuspended(bool bSuspended)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueAudio_SetWorldMusicSuspended);
+
+    bWorldMusicSuspended = bSuspended;
+    UpdateWorldMusicPaused();
 }
 
-void URogueAudioSubsystem::StartGameOverMusic()
+void URogueAudioSubsystem::UpdateWorldMusicPaused()
 {
-    if (!IsValid(WorldMusicPlayer))
+    // Pausing and suspending overlap (e.g. the game is paused when the window loses focus), only resume once neither applies
+    const bool bShouldPause = bWorldMusicPausedByGame || bWorldMusicSuspended || bWorldMusicPausedForLoading;
+
+    // Both decks, the outgoing one may still be fading out
+    for (UAudioComponent* MusicDeck : MusicDecks)
     {
+        if (IsValid(MusicDeck) && MusicDeck->bIsPaused != bShouldPause)
+        {
+            MusicDeck->SetPaused(bShouldPause);
+        }
+    }
+}
+
+void URogueAudioSubsystem::StartVictoryMusic()
+{
+    if (!IsValid(LevelCompleteMusic))
+    {
+        // No music found so we'll just fade out the music and return
+        FadeOutMusic();
         return;
     }
 
-    WorldMusicPlayer->Stop();
+    TransitionToMusic(LevelCompleteMusic, true);
+}
 
+void URogueAudioSubsystem::StartGameOverMusic()
+{
     if (!IsValid(LevelFailMusic))
     {
-        // No music found so we'll just stop the music player and return
+        // No music found so we'll just fade out the music and return
+        FadeOutMusic();
         return;
     }
 
-    // Set the new sound and play
-    WorldMusicPlayer->SetSound(LevelFailMusic);
-    WorldMusicPlayer->Play();
+    TransitionToMusic(LevelFailMusic, true);
+}
+
+bool URogueAudioSubsystem::RunAudioBenchmark(int32 Iterations)
+{
+    if (!bAudioAssetsLoaded || !IsValid(CurrentWorld) || !IsValid(CurrentGameSettings))
+    {
+        UE_LOG(LogRogueAudioSubsystem, Warning, TEXT("URogueAudioSubsystem::RunAudioBenchmark needs a world with loaded audio assets and game user settings."));
+        return false;
+    }
+
+    Iterations = FMath::Max(Iterations, 1);
+
+    // Cost of one kind of operation over all iterations
+    struct FBenchmarkOperation
+    {
+        const TCHAR* Name  = nullptr;
+        uint64 TotalCycles = 0;
+        uint64 MaxCycles   = 0;
+        int32 Count        = 0;
+
+        void Measure(TFunctionRef<void()> Work)
+        {
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            Work();
+            const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+            TotalCycles += Cycles;
+            MaxCycles = FMath::Max(MaxCycles, Cycles);
+            ++Count;
+        }
+    };
+
+    FBenchmarkOperation SetVolume = {TEXT("SetVolume (staged)")};
+    FBenchmarkOperation FlushMix  = {TEXT("FlushMixChanges")};
+    FBenchmarkOperation Paused    = {TEXT("GameStateChanged Paused")};
+    FBenchmarkOperation Running   = {TEXT("GameStateChanged Running")};
+    FBenchmarkOperation GameOver  = {TEXT("GameStateChanged GameOver")};
+    FBenchmarkOperation Victory   = {TEXT("GameStateChanged Victory")};
+    const FBenchmarkOperation* const Operations[] = {&SetVolume, &FlushMix, &Paused, &Running, &GameOver, &Victory};
+
+    const float InitialMainVolume  = CurrentGameSettings->MainVolume;
+    const float InitialMusicVolume = CurrentGameSettings->MusicVolume;
+    const float InitialSFXVolume   = CurrentGameSettings->SFXVolume;
+
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        // A slider drag: several volume changes within one frame, then the flush the ticker would run on the next one
+        const float Volume = static_cast<float>(Iteration % 11) / 10.0f;
+        SetVolume.Measure([this, Volume]() { SetMainVolume(Volume); });
+        SetVolume.Measure([this, Volume]() { SetMusicVolume(Volume); });
+        SetVolume.Measure([this, Volume]() { SetSFXVolume(Volume); });
+
+        FTSTicker::GetCoreTicker().RemoveTicker(MixFlushTickerHandle);
+        FlushMix.Measure([this]() { FlushMixChanges(0.0f); });
+
+        Paused.Measure([this]() { GameStateChanged(ELevelState::Paused); });
+        Running.Measure([this]() { GameStateChanged(ELevelState::Running); });
+        GameOver.Measure([this]() { GameStateChanged(ELevelState::GameOver); });
+        Victory.Measure([this]() { GameStateChanged(ELevelState::Victory); });
+    }
+
+    const FAudioDeviceHandle AudioDevice = CurrentWorld->GetAudioDevice();
+    UE_LOG(LogRogueAudioSubsystem, Log, TEXT("URogueAudioSubsystem audio benchmark, %d iterations, %s:"), Iterations, AudioDevice ? TEXT("audio device") : TEXT("null audio device"));
+
+    for (const FBenchmarkOperation* Operation : Operations)
+    {
+        const double AverageUs = FPlatformTime::ToMilliseconds64(Operation->TotalCycles) * 1000.0 / FMath::Max(Operation->Count, 1);
+        const double MaxUs     = FPlatformTime::ToMilliseconds64(Operation->MaxCycles) * 1000.0;
+        UE_LOG(LogRogueAudioSubsystem, Log, TEXT("    %-28s %6d calls, avg %8.2f us, max %8.2f us"), Operation->Name, Operation->Count, AverageUs, MaxUs);
+    }
+
+    // Put the volumes, pause and music back the way the level had them
+    SetMainVolume(InitialMainVolume);
+    SetMusicVolume(InitialMusicVolume);
+    SetSFXVolume(InitialSFXVolume);
+
+    const ELevelState LevelState = IsValid(RogueGameState) ? RogueGameState->GetLevelState() : ELevelState::Running;
+    GameStateChanged(LevelState);
+    if (LevelState == ELevelState::Running || LevelState == ELevelState::Paused)
+    {
+        StartDefaultWorldMusic();
+    }
+
+    return true;
 }
 
 TObjectPtr<URogueGameUserSettings> URogueAudioSubsystem::GetRogueGameSettings()
@@ -2,7 +2,10 @@
 
 #include "Character/RogueCharacterBase.h"
 
+#include "Audio/RogueAudioSubsystem.h"
 #include "Engine/EngineTypes.h"
+#include "Engine/GameInstance.h"
+#include "Game/RogueGameplayTags.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 
@@ -12,12 +15,16 @@
 ARogueCharacterBase::ARogueCharacterBase()
 {
     PrimaryActorTick.bCanEverTick = false;
+
+    HitAudioEvent   = Tags::Audio_Event_Character_Hit;
+    DeathAudioEvent = Tags::Audio_Event_Character_Death;
 }
 
-void ARogueCharacterBase::BeginPlay()
+void ARogueCharacterBase::PostInitializeComponents()
 {
-    Super::BeginPlay();
+    Super::PostInitializeComponents();
 
+    // Set before the character is possessed, so the HUD reads the full hit points when it binds to the new pawn
     CurrentHitPoints = HitPoints;
 }
 
@@ -62,6 +69,8 @@ void ARogueCharacterBase::CharacterDeath()
     // won't play to trigger the anim notify, so we call it manually.
     OnAnimNotifyHitEffect_BP();
 
+    PostAudioEvent(DeathAudioEvent);
+
     // Invoke the BlueprintImplementable Event so the derived blueprint class knows
     OnCharacterDeath_BP();
     // Broadcast the delegate so any subscribed classes or blueprints know
@@ -75,6 +84,8 @@ void ARogueCharacterBase::HitCharacter()
 
     CurrentHitPoints = (CurrentHitPoints > 0) ? CurrentHitPoints - 1 : 0;
 
+    PostAudioEvent(HitAudioEvent);
+
     OnCharacterHit_BP();
     OnCharacterHit.Broadcast();
 
@@ -108,3 +119,19 @@ void ARogueCharacterBase::KillCharacter()
         CharacterDeath();
     }
 }
+
+void ARogueCharacterBase::PostAudioEvent(const FGameplayTag& EventTag) const
+{
+    if (!EventTag.IsValid())
+    {
+        return;
+    }
+
+    if (const UGameInstance* GameInstance = GetGameInstance())
+    {
+        if (URogueAudioSubsystem* AudioSubsystem = GameInstance->GetSubsystem<URogueAudioSubsystem>())
+        {
+            AudioSubsystem->PostAudioEvent(EventTag, GetActorLocation());
+        }
+    }
+}
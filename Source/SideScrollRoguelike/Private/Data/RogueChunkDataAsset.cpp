@@ -0,0 +1,5 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/RogueChunkDataAsset.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueChunkDataAsset)
@@ -2,10 +2,19 @@
 
 #include "Game/RogueGameInstance.h"
 
+#include "Audio/RogueAudioSubsystem.h"
+#include "Components/ActorComponent.h"
+#include "EngineUtils.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Game/RogueGameState.h"
+#include "Game/RogueGameTypes.h"
 #include "GameMapsSettings.h"
 #include "LoadingScreenManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Particles/FXSystemComponent.h"
+#include "Settings/RogueDeveloperSettings.h"
 
+#include "Engine/Engine.h"
 #include "Engine/World.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RogueGameInstance)
@@ -32,7 +41,18 @@ void URogueGameInstance::SetHasPlayedBootSplash(bool bPlayed)
 
 void URogueGameInstance::HoldLoadingScreen(bool bHold)
 {
+    if (bHoldLoadingScreen == bHold)
+    {
+        return;
+    }
+
     bHoldLoadingScreen = bHold;
+
+    // The loading screen manager only re-checks its processors when told something changed
+    if (ULoadingScreenManager* LoadingScreenManager = GetSubsystem<ULoadingScreenManager>())
+    {
+        LoadingScreenManager->MarkLoadingScreenStateDirty();
+    }
 }
 
 bool URogueGameInstance::ShouldHoldLoadingScreen() const
@@ -55,6 +75,13 @@ void URogueGameInstance::Init()
     }
 }
 
+void URogueGameInstance::Shutdown()
+{
+    ExitBackgroundMode();
+
+    Super::Shutdown();
+}
+
 #if WITH_EDITOR
 FGameInstancePIEResult URogueGameInstance::InitializeForPlayInEditor(int32 PIEInstanceIndex, const FGameInstancePIEParameters& Params)
 {
@@ -86,16 +113,167 @@ void URogueGameInstance::WindowFocusChanged(bool bIsFocused)
 #if !WITH_EDITOR
     if (bIsFocused)
     {
-        // Unlimit game FPS
-        GEngine->SetMaxFPS(0);
+        ExitBackgroundMode();
     }
     else
     {
-        // Reduce FPS to max 10 while in the background
-        GEngine->SetMaxFPS(10.0f);
+        EnterBackgroundMode();
     }
 #endif
 
     // Broadcast to any listening blueprints
     OnWindowFocusChanged.Broadcast(bIsFocused);
 }
+
+void URogueGameInstance::EnterBackgroundMode()
+{
+    if (bInBackgroundMode)
+    {
+        return;
+    }
+
+    bInBackgroundMode = true;
+
+    const URogueDeveloperSettings* Settings = GetDefault<URogueDeveloperSettings>();
+
+    // Reduce FPS while in the background
+    GEngine->SetMaxFPS(Settings->BackgroundMaxFPS);
+
+    if (Settings->bPauseGameInBackground)
+    {
+        ARogueGameState* GameState = GetWorld() ? GetWorld()->GetGameState<ARogueGameState>() : nullptr;
+        if (GameState && GameState->GetLevelState() == ELevelState::Running)
+        {
+            GameState->PauseGame();
+            bPausedForBackground = true;
+        }
+    }
+
+    if (Settings->bSuspendMusicInBackground)
+    {
+        if (URogueAudioSubsystem* AudioSubsystem = GetSubsystem<URogueAudioSubsystem>())
+        {
+            AudioSubsystem->SetWorldMusicSuspended(true);
+        }
+    }
+
+    if (Settings->BackgroundCosmeticTickInterval > 0.0f)
+    {
+        ThrottleCosmeticComponents(Settings->BackgroundCosmeticTickInterval);
+    }
+
+    if (Settings->BackgroundTrimDelaySeconds > 0.0f)
+    {
+        TrimTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::TrimAfterGracePeriod), Settings->BackgroundTrimDelaySeconds);
+    }
+
+    // Measure what the game still costs while nobody is looking at it
+    BackgroundStartTime      = FPlatformTime::Seconds();
+    BackgroundCPUSampleSum   = 0.0;
+    BackgroundCPUSampleCount = 0;
+    CPUSampleTickerHandle    = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::SampleBackgroundCPU), 1.0f);
+}
+
+void URogueGameInstance::ExitBackgroundMode()
+{
+    if (!bInBackgroundMode)
+    {
+        return;
+    }
+
+    bInBackgroundMode = false;
+
+    // Unlimit game FPS
+    GEngine->SetMaxFPS(0);
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TrimTickerHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(CPUSampleTickerHandle);
+    TrimTickerHandle.Reset();
+    CPUSampleTickerHandle.Reset();
+
+    RestoreCosmeticComponents();
+
+    if (URogueAudioSubsystem* AudioSubsystem = GetSubsystem<URogueAudioSubsystem>())
+    {
+        AudioSubsystem->SetWorldMusicSuspended(false);
+    }
+
+    // Only undo our own pause, the player may have opened the pause menu in the meantime
+    if (bPausedForBackground)
+    {
+        bPausedForBackground = false;
+
+        if (ARogueGameState* GameState = GetWorld() ? GetWorld()->GetGameState<ARogueGameState>() : nullptr)
+        {
+            GameState->UnPauseGame();
+        }
+    }
+
+    BackgroundCPUUsage = BackgroundCPUSampleCount > 0 ? float(BackgroundCPUSampleSum / BackgroundCPUSampleCount) : 0.0f;
+
+    UE_LOG(LogGame, Log, TEXT("Spent %.1fs in the background using %.1f%% CPU on average."), FPlatformTime::Seconds() - BackgroundStartTime, BackgroundCPUUsage);
+}
+
+void URogueGameInstance::ThrottleCosmeticComponents(float TickInterval)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const FName CosmeticTag = GetDefault<URogueDeveloperSettings>()->CosmeticComponentTag;
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        for (UActorComponent* Component : It->GetComponents())
+        {
+            if (!Component || !Component->IsComponentTickEnabled())
+            {
+                continue;
+            }
+
+            const bool bIsCosmetic = Component->IsA<UFXSystemComponent>() || (!CosmeticTag.IsNone() && Component->ComponentHasTag(CosmeticTag));
+            if (bIsCosmetic && Component->GetComponentTickInterval() < TickInterval)
+            {
+                ThrottledComponentIntervals.Add(Component, Component->GetComponentTickInterval());
+                Component->SetComponentTickInterval(TickInterval);
+            }
+        }
+    }
+}
+
+void URogueGameInstance::RestoreCosmeticComponents()
+{
+    for (const TPair<TWeakObjectPtr<UActorComponent>, float>& Entry : ThrottledComponentIntervals)
+    {
+        if (UActorComponent* Component = Entry.Key.Get())
+        {
+            Component->SetComponentTickInterval(Entry.Value);
+        }
+    }
+
+    ThrottledComponentIntervals.Reset();
+}
+
+bool URogueGameInstance::TrimAfterGracePeriod(float DeltaTime)
+{
+    TrimTickerHandle.Reset();
+
+    UE_LOG(LogGame, Log, TEXT("In the background for %.0fs, trimming memory."), FPlatformTime::Seconds() - BackgroundStartTime);
+
+    // Pools and caches listen to the memory trim delegate, anything they drop is collected right after
+    FCoreDelegates::GetMemoryTrimDelegate().Broadcast();
+    GEngine->ForceGarbageCollection(true);
+
+    // Only trim once per time in the background
+    return false;
+}
+
+bool URogueGameInstance::SampleBackgroundCPU(float DeltaTime)
+{
+    BackgroundCPUSampleSum += FPlatformTime::GetCPUTime().CPUTimePct;
+    ++BackgroundCPUSampleCount;
+
+    return true;
+}
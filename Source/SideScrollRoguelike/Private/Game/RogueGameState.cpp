@@ -86,6 +86,7 @@ void ARogueGameState::HandleReady()
 	// Initialize our transient properties when a level is loaded but before it starts. 
 	RemainingTime = TimePerLevel;
 	AccumulatedTime = 0; 
+	BroadcastRemainingSeconds();
 
 	SetLevelState(ELevelState::Running);
 }
@@ -158,11 +159,23 @@ void ARogueGameState::Tick(float DeltaTime)
 			RemainingTime = 0; 
 			SetLevelState(ELevelState::GameOver);
 		}
+
+		BroadcastRemainingSeconds();
 	}
 
 	Super::Tick(DeltaTime); 
 }
 
+void ARogueGameState::BroadcastRemainingSeconds()
+{
+	const int32 RemainingSeconds = GetRemainingSeconds();
+	if (RemainingSeconds != LastBroadcastRemainingSeconds)
+	{
+		LastBroadcastRemainingSeconds = RemainingSeconds;
+		OnRemainingSecondsChanged.Broadcast(RemainingSeconds);
+	}
+}
+
 bool ARogueGameState::HasMatchEnded() const
 {
 	return (LevelState == ELevelState::GameOver) || (LevelState == ELevelState::Victory);
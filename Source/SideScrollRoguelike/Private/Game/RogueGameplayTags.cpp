@@ -8,4 +8,10 @@ namespace Tags
     UE_DEFINE_GAMEPLAY_TAG(UI_Layer_Menu, "UI.Layer.Menu");
     UE_DEFINE_GAMEPLAY_TAG(UI_Layer_Modal, "UI.Layer.Modal");
 
+    UE_DEFINE_GAMEPLAY_TAG(Audio_Event_Character_Hit, "Audio.Event.Character.Hit");
+    UE_DEFINE_GAMEPLAY_TAG(Audio_Event_Character_Death, "Audio.Event.Character.Death");
+    UE_DEFINE_GAMEPLAY_TAG(Audio_Event_Player_EnemyBounce, "Audio.Event.Player.EnemyBounce");
+    UE_DEFINE_GAMEPLAY_TAG(Audio_Event_Player_Pickup_Health, "Audio.Event.Player.Pickup.Health");
+    UE_DEFINE_GAMEPLAY_TAG(Audio_Event_Player_Pickup_Speed, "Audio.Event.Player.Pickup.Speed");
+
 }
\ No newline at end of file
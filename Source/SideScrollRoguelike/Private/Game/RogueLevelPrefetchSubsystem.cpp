@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Game/RogueLevelPrefetchSubsystem.h"
+
+#include "Data/RogueMapDataAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Engine/WorldInitializationValues.h"
+#include "Game/RogueGameState.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CoreDelegates.h"
+#include "Settings/RogueDeveloperSettings.h"
+#include "Settings/RogueWorldSettings.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueLevelPrefetchSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueLevelPrefetch);
+
+void URogueLevelPrefetchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Bind to world initialization so that the prefetcher knows about the world state (BeginPlay)
+    PostWorldCreationHandle = FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &ThisClass::WorldInitialization);
+    PostLoadMapHandle       = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::PostLoadMap);
+
+    // Give the memory back whenever the platform asks us to trim
+    MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddUObject(this, &ThisClass::CancelPrefetch);
+}
+
+void URogueLevelPrefetchSubsystem::Deinitialize()
+{
+    CancelPrefetch();
+
+    FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldCreationHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+
+    Super::Deinitialize();
+}
+
+void URogueLevelPrefetchSubsystem::WorldInitialization(UWorld* World, const FWorldInitializationValues IVS)
+{
+    // Only game worlds owned by our game instance are interesting. PIE worlds are duplicated from the editor
+    // and would not use a prefetched package anyway.
+    if (!World || World->WorldType != EWorldType::Game || World->GetGameInstance() != GetGameInstance())
+    {
+        return;
+    }
+
+    CurrentWorld               = World;
+    bAttemptedPrefetchForLevel = false;
+    World->GameStateSetEvent.AddUObject(this, &ThisClass::GameStateSet);
+}
+
+void URogueLevelPrefetchSubsystem::GameStateSet(AGameStateBase* GameState)
+{
+    if (ARogueGameState* NewRogueGameState = Cast<ARogueGameState>(GameState))
+    {
+        RogueGameState = NewRogueGameState;
+        NewRogueGameState->OnLevelStateChanged.AddUniqueDynamic(this, &ThisClass::GameStateChanged);
+
+        // In case the state already moved on before the game state was set on the world
+        if (NewRogueGameState->GetLevelState() == ELevelState::Running)
+        {
+            GameStateChanged(ELevelState::Running);
+        }
+    }
+}
+
+void URogueLevelPrefetchSubsystem::GameStateChanged(ELevelState NewLevelState)
+{
+    // Running is entered again after every pause, only start once per level
+    if (NewLevelState != ELevelState::Running || bAttemptedPrefetchForLevel || !CurrentWorld.IsValid())
+    {
+        return;
+    }
+
+    bAttemptedPrefetchForLevel = true;
+
+    if (!GetDefault<URogueDeveloperSettings>()->bEnableLevelPrefetch)
+    {
+        return;
+    }
+
+    const ARogueWorldSettings* WorldSettings = Cast<ARogueWorldSettings>(CurrentWorld->GetWorldSettings());
+    if (WorldSettings && !WorldSettings->NextLevel.IsNull())
+    {
+        PrefetchLevel(WorldSettings->NextLevel);
+    }
+}
+
+void URogueLevelPrefetchSubsystem::PrefetchLevel(TSoftObjectPtr<URogueMapDataAsset> MapData)
+{
+    CancelPrefetch();
+
+    if (MapData.IsNull())
+    {
+        return;
+    }
+
+    if (!HasMemoryBudget())
+    {
+        UE_LOG(LogRogueLevelPrefetch, Log, TEXT("URogueLevelPrefetchSubsystem::PrefetchLevel skipping %s, not enough free memory."), *MapData.ToString());
+        return;
+    }
+
+    PrefetchedMapData = MapData;
+    PrefetchStartTime = FPlatformTime::Seconds();
+
+    const int32 Priority = GetDefault<URogueDeveloperSettings>()->LevelPrefetchPriority;
+    MapDataHandle        = UAssetManager::GetStreamableManager().RequestAsyncLoad(MapData.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &ThisClass::MapDataLoaded), Priority);
+}
+
+void URogueLevelPrefetchSubsystem::MapDataLoaded()
+{
+    const URogueMapDataAsset* MapData = PrefetchedMapData.Get();
+    if (!MapData || MapData->Level.IsNull())
+    {
+        UE_LOG(LogRogueLevelPrefetch, Warning, TEXT("URogueLevelPrefetchSubsystem::MapDataLoaded %s has no level to prefetch."), *PrefetchedMapData.ToString());
+        return;
+    }
+
+    UsedPhysicalAtLevelLoadStart = FPlatformMemory::GetStats().UsedPhysical;
+
+    // Loading the world through the streamable manager pulls in the package and everything it references.
+    // The handle keeps it all resident until the travel to the level picks it up.
+    const int32 Priority = GetDefault<URogueDeveloperSettings>()->LevelPrefetchPriority;
+    LevelHandle          = UAssetManager::GetStreamableManager().RequestAsyncLoad(MapData->Level.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &ThisClass::LevelLoaded), Priority);
+}
+
+void URogueLevelPrefetchSubsystem::LevelLoaded()
+{
+    const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+    const uint64 Cost         = UsedPhysical > UsedPhysicalAtLevelLoadStart ? UsedPhysical - UsedPhysicalAtLevelLoadStart : 0;
+    const uint64 Budget       = uint64(GetDefault<URogueDeveloperSettings>()->LevelPrefetchMemoryBudgetMB) * 1024 * 1024;
+
+    UE_LOG(LogRogueLevelPrefetch, Log, TEXT("URogueLevelPrefetchSubsystem::LevelLoaded prefetched %s in %.2fs using ~%.1fMB."),
+        *PrefetchedMapData.ToString(), FPlatformTime::Seconds() - PrefetchStartTime, double(Cost) / (1024.0 * 1024.0));
+
+    if (Cost > Budget)
+    {
+        UE_LOG(LogRogueLevelPrefetch, Warning, TEXT("URogueLevelPrefetchSubsystem::LevelLoaded prefetch of %s exceeded the %dMB budget, releasing it."),
+            *PrefetchedMapData.ToString(), GetDefault<URogueDeveloperSettings>()->LevelPrefetchMemoryBudgetMB);
+        CancelPrefetch();
+    }
+}
+
+void URogueLevelPrefetchSubsystem::PostLoadMap(UWorld* World)
+{
+    if (World && World->GetGameInstance() == GetGameInstance())
+    {
+        // Whether the travel used the prefetched level or not, the references are no longer needed
+        CancelPrefetch();
+        RogueGameState.Reset();
+    }
+}
+
+void URogueLevelPrefetchSubsystem::CancelPrefetch()
+{
+    if (MapDataHandle.IsValid())
+    {
+        MapDataHandle->CancelHandle();
+        MapDataHandle.Reset();
+    }
+
+    if (LevelHandle.IsValid())
+    {
+        LevelHandle->ReleaseHandle();
+        LevelHandle.Reset();
+    }
+
+    PrefetchedMapData.Reset();
+}
+
+bool URogueLevelPrefetchSubsystem::IsPrefetchComplete() const
+{
+    return LevelHandle.IsValid() && LevelHandle->HasLoadCompleted();
+}
+
+bool URogueLevelPrefetchSubsystem::HasMemoryBudget() const
+{
+    const uint64 Budget = uint64(GetDefault<URogueDeveloperSettings>()->LevelPrefetchMemoryBudgetMB) * 1024 * 1024;
+    return FPlatformMemory::GetStats().AvailablePhysical >= Budget;
+}
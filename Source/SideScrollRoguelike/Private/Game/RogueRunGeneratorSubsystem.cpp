@@ -0,0 +1,428 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Game/RogueRunGeneratorSubsystem.h"
+
+#include "Async/Async.h"
+#include "Data/RogueChunkDataAsset.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Engine/World.h"
+#include "Game/RogueRandomStream.h"
+#include "Game/RogueRunSeedSubsystem.h"
+#include "LoadingScreenManager.h"
+#include "Settings/RogueDeveloperSettings.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueRunGeneratorSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueRunGenerator);
+
+namespace
+{
+    // Plain copy of the chunk data the worker thread needs. UObjects are never touched off the game thread.
+    struct FChunkDescriptor
+    {
+        int32 PoolIndex = INDEX_NONE;
+        float Length = 0.0f;
+        float EntryHeight = 0.0f;
+        float ExitHeight = 0.0f;
+        float Weight = 0.0f;
+        FGameplayTagContainer DifficultyTags;
+    };
+
+    // Picks and lays out chunks along the X-axis. Runs on a worker thread.
+    TArray<FRogueChunkLayoutSlot> BuildLayout(const TArray<FChunkDescriptor>& Pool, const FRogueRunGenerationParams& Params, FRogueRandomStream Stream)
+    {
+        // Only keep the chunks matching the requested difficulty
+        TArray<const FChunkDescriptor*> Candidates;
+        Candidates.Reserve(Pool.Num());
+        for (const FChunkDescriptor& Descriptor : Pool)
+        {
+            if (Params.DifficultyTags.IsEmpty() || Descriptor.DifficultyTags.HasAny(Params.DifficultyTags))
+            {
+                Candidates.Add(&Descriptor);
+            }
+        }
+
+        TArray<FRogueChunkLayoutSlot> Layout;
+        if (Candidates.Num() == 0)
+        {
+            UE_LOG(LogRogueRunGenerator, Warning, TEXT("BuildLayout: no chunk in the pool matches difficulty %s"), *Params.DifficultyTags.ToStringSimple());
+            return Layout;
+        }
+
+        Layout.Reserve(Params.NumChunks);
+
+        TArray<const FChunkDescriptor*> ValidChunks;
+        ValidChunks.Reserve(Candidates.Num());
+
+        const FChunkDescriptor* Previous = nullptr;
+        FVector Location = Params.Origin;
+
+        for (int32 SlotIndex = 0; SlotIndex < Params.NumChunks; ++SlotIndex)
+        {
+            ValidChunks.Reset();
+            float TotalWeight = 0.0f;
+
+            for (const FChunkDescriptor* Candidate : Candidates)
+            {
+                if (Previous)
+                {
+                    // Avoid repeating the same chunk back to back when there is an alternative
+                    if (Candidate == Previous && Candidates.Num() > 1)
+                    {
+                        continue;
+                    }
+
+                    // The player has to be able to get from the previous exit to this entry
+                    if (FMath::Abs(Candidate->EntryHeight - Previous->ExitHeight) > Params.MaxHeightStep)
+                    {
+                        continue;
+                    }
+                }
+
+                ValidChunks.Add(Candidate);
+                TotalWeight += Candidate->Weight;
+            }
+
+            const FChunkDescriptor* Picked = nullptr;
+            if (ValidChunks.Num() == 0)
+            {
+                // Nothing connects cleanly, fall back to the chunk with the smallest height step
+                float SmallestStep = TNumericLimits<float>::Max();
+                for (const FChunkDescriptor* Candidate : Candidates)
+                {
+                    const float Step = FMath::Abs(Candidate->EntryHeight - Previous->ExitHeight);
+                    if (Step < SmallestStep)
+                    {
+                        SmallestStep = Step;
+                        Picked       = Candidate;
+                    }
+                }
+
+                UE_LOG(LogRogueRunGenerator, Warning, TEXT("BuildLayout: no chunk connects within %.0f at slot %d, using a %.0f step"), Params.MaxHeightStep, SlotIndex, SmallestStep);
+            }
+            else if (TotalWeight <= 0.0f)
+            {
+                Picked = ValidChunks[Stream.RandHelper(ValidChunks.Num())];
+            }
+            else
+            {
+                // Weighted pick
+                float Roll = Stream.FRandRange(0.0f, TotalWeight);
+                Picked     = ValidChunks.Last();
+                for (const FChunkDescriptor* Candidate : ValidChunks)
+                {
+                    Roll -= Candidate->Weight;
+                    if (Roll <= 0.0f)
+                    {
+                        Picked = Candidate;
+                        break;
+                    }
+                }
+            }
+
+            Layout.Add({Picked->PoolIndex, Location});
+
+            Location.X += Picked->Length;
+            Previous = Picked;
+        }
+
+        return Layout;
+    }
+} // namespace
+
+void URogueRunGeneratorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+    {
+        if (ULoadingScreenManager* LoadingScreenManager = GameInstance->GetSubsystem<ULoadingScreenManager>())
+        {
+            LoadingScreenManager->RegisterLoadingProcessor(this);
+        }
+    }
+}
+
+void URogueRunGeneratorSubsystem::Deinitialize()
+{
+    if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+    {
+        if (ULoadingScreenManager* LoadingScreenManager = GameInstance->GetSubsystem<ULoadingScreenManager>())
+        {
+            LoadingScreenManager->UnregisterLoadingProcessor(this);
+        }
+    }
+
+    Super::Deinitialize();
+}
+
+void URogueRunGeneratorSubsystem::MarkLoadingScreenStateDirty() const
+{
+    // The loading screen manager only re-checks its processors when told something changed
+    const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+    if (ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr)
+    {
+        LoadingScreenManager->MarkLoadingScreenStateDirty();
+    }
+}
+
+bool URogueRunGeneratorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool URogueRunGeneratorSubsystem::ShouldShowLoadingScreen(FString& OutReason) const
+{
+    if (bLayoutInFlight)
+    {
+        OutReason = TEXT("RogueRunGenerator is building the run layout");
+        return true;
+    }
+
+    if (bChunkStreamingTimedOut)
+    {
+        return false;
+    }
+
+    for (const ULevelStreamingDynamic* StreamedChunk : StreamedChunks)
+    {
+        if (IsChunkPending(StreamedChunk))
+        {
+            OutReason = FString::Printf(TEXT("RogueRunGenerator is streaming chunk %s"), *StreamedChunk->GetWorldAssetPackageName());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void URogueRunGeneratorSubsystem::GenerateRun(const FRogueRunGenerationParams& Params)
+{
+    UnloadRun();
+
+    // Snapshot the chunk pool into plain data for the worker thread
+    TArray<FChunkDescriptor> Descriptors;
+    Descriptors.Reserve(Params.ChunkPool.Num());
+
+    for (int32 PoolIndex = 0; PoolIndex < Params.ChunkPool.Num(); ++PoolIndex)
+    {
+        const URogueChunkDataAsset* Chunk = Params.ChunkPool[PoolIndex];
+        if (!IsValid(Chunk) || Chunk->Level.IsNull())
+        {
+            UE_LOG(LogRogueRunGenerator, Warning, TEXT("URogueRunGeneratorSubsystem::GenerateRun skipping chunk %d, it is null or has no level."), PoolIndex);
+            continue;
+        }
+
+        FChunkDescriptor& Descriptor = Descriptors.AddDefaulted_GetRef();
+        Descriptor.PoolIndex         = PoolIndex;
+        Descriptor.Length            = Chunk->Length;
+        Descriptor.EntryHeight       = Chunk->EntryHeight;
+        Descriptor.ExitHeight        = Chunk->ExitHeight;
+        Descriptor.Weight            = Chunk->SelectionWeight;
+        Descriptor.DifficultyTags    = Chunk->DifficultyTags;
+    }
+
+    if (Descriptors.Num() == 0)
+    {
+        UE_LOG(LogRogueRunGenerator, Error, TEXT("URogueRunGeneratorSubsystem::GenerateRun the chunk pool is empty."));
+        return;
+    }
+
+    PendingChunkPool = Params.ChunkPool;
+    bLayoutInFlight  = true;
+    MarkLoadingScreenStateDirty();
+
+    // Params are copied without the chunk pool so the worker never holds UObject references
+    FRogueRunGenerationParams WorkerParams = Params;
+    WorkerParams.ChunkPool.Reset();
+
+    // Without an explicit seed the layout follows the seed of the current run
+    FRogueRandomStream Stream(uint64(Params.Seed));
+    if (Params.Seed == 0)
+    {
+        if (const URogueRunSeedSubsystem* RunSeed = GetWorld()->GetGameInstance()->GetSubsystem<URogueRunSeedSubsystem>())
+        {
+            Stream = RunSeed->MakeStream(TEXT("RunLayout"));
+        }
+    }
+
+    const uint32 RequestId = ++CurrentRequestId;
+    Async(EAsyncExecution::TaskGraph, [WeakThis = TWeakObjectPtr<ThisClass>(this), RequestId, Descriptors = MoveTemp(Descriptors), WorkerParams, Stream]()
+    {
+        TArray<FRogueChunkLayoutSlot> Layout = BuildLayout(Descriptors, WorkerParams, Stream);
+
+        // Hand the result back to the game thread for streaming
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, Layout = MoveTemp(Layout)]()
+        {
+            if (URogueRunGeneratorSubsystem* Generator = WeakThis.Get())
+            {
+                Generator->StreamLayout(RequestId, Layout);
+            }
+        });
+    });
+}
+
+void URogueRunGeneratorSubsystem::StreamLayout(uint32 RequestId, const TArray<FRogueChunkLayoutSlot>& Layout)
+{
+    // A newer request or an unload superseded this one
+    if (RequestId != CurrentRequestId)
+    {
+        return;
+    }
+
+    bLayoutInFlight = false;
+
+    UWorld* World = GetWorld();
+    Placements.Reserve(Layout.Num());
+    StreamedChunks.Reserve(Layout.Num());
+
+    for (const FRogueChunkLayoutSlot& Slot : Layout)
+    {
+        URogueChunkDataAsset* Chunk = PendingChunkPool.IsValidIndex(Slot.PoolIndex) ? PendingChunkPool[Slot.PoolIndex].Get() : nullptr;
+        if (!IsValid(Chunk))
+        {
+            continue;
+        }
+
+        // Every instance needs a unique name, the same chunk can appear several times in a run
+        const FString InstanceName = FString::Printf(TEXT("RogueChunk_%u_%d"), RequestId, Placements.Num());
+
+        bool bSuccess = false;
+        ULevelStreamingDynamic* StreamedChunk = ULevelStreamingDynamic::LoadLevelInstanceBySoftObjectPtr(World, Chunk->Level, Slot.Location, FRotator::ZeroRotator, bSuccess, InstanceName);
+
+        if (!bSuccess || !StreamedChunk)
+        {
+            UE_LOG(LogRogueRunGenerator, Error, TEXT("URogueRunGeneratorSubsystem::StreamLayout failed to stream chunk %s."), *Chunk->GetName());
+            continue;
+        }
+
+        StreamedChunk->OnLevelLoaded.AddDynamic(this, &ThisClass::ChunkStreamingChanged);
+        StreamedChunk->OnLevelShown.AddDynamic(this, &ThisClass::ChunkStreamingChanged);
+
+        StreamedChunks.Add(StreamedChunk);
+        Placements.Add({Chunk, Slot.Location});
+    }
+
+    PendingChunkPool.Reset();
+
+    // Failed loads are not broadcast, they are picked up by polling along with the timeout
+    ChunkStreamingStartTime = FPlatformTime::Seconds();
+    if (StreamedChunks.Num() > 0)
+    {
+        World->GetTimerManager().SetTimer(ChunkStreamingTimerHandle, this, &ThisClass::UpdateChunkStreaming, 0.25f, true);
+    }
+
+    UE_LOG(LogRogueRunGenerator, Log, TEXT("URogueRunGeneratorSubsystem::StreamLayout streaming %d chunks."), StreamedChunks.Num());
+
+    MarkLoadingScreenStateDirty();
+
+    OnRunLayoutStreamed.Broadcast(Placements);
+}
+
+void URogueRunGeneratorSubsystem::UnloadRun()
+{
+    // Drop the result of any layout still being built
+    ++CurrentRequestId;
+    bLayoutInFlight         = false;
+    bChunkStreamingTimedOut = false;
+    PendingChunkPool.Reset();
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(ChunkStreamingTimerHandle);
+    }
+
+    for (ULevelStreamingDynamic* StreamedChunk : StreamedChunks)
+    {
+        if (IsValid(StreamedChunk))
+        {
+            StreamedChunk->OnLevelLoaded.RemoveAll(this);
+            StreamedChunk->OnLevelShown.RemoveAll(this);
+            StreamedChunk->SetIsRequestingUnloadAndRemoval(true);
+        }
+    }
+
+    StreamedChunks.Reset();
+    Placements.Reset();
+
+    MarkLoadingScreenStateDirty();
+}
+
+void URogueRunGeneratorSubsystem::ChunkStreamingChanged()
+{
+    UpdateChunkStreaming();
+
+    // A chunk finished loading or became visible
+    MarkLoadingScreenStateDirty();
+}
+
+void URogueRunGeneratorSubsystem::UpdateChunkStreaming()
+{
+    // A chunk that failed to load never becomes visible, stop waiting for it
+    for (int32 ChunkIndex = StreamedChunks.Num() - 1; ChunkIndex >= 0; --ChunkIndex)
+    {
+        ULevelStreamingDynamic* StreamedChunk = StreamedChunks[ChunkIndex];
+        if (IsValid(StreamedChunk) && StreamedChunk->GetLevelStreamingState() != ELevelStreamingState::FailedToLoad)
+        {
+            continue;
+        }
+
+        UE_LOG(LogRogueRunGenerator, Error, TEXT("URogueRunGeneratorSubsystem::UpdateChunkStreaming chunk %s failed to load, dropping it from the run."),
+            IsValid(StreamedChunk) ? *StreamedChunk->GetWorldAssetPackageName() : TEXT("None"));
+
+        if (IsValid(StreamedChunk))
+        {
+            StreamedChunk->OnLevelLoaded.RemoveAll(this);
+            StreamedChunk->OnLevelShown.RemoveAll(this);
+            StreamedChunk->SetIsRequestingUnloadAndRemoval(true);
+        }
+
+        StreamedChunks.RemoveAt(ChunkIndex);
+        if (Placements.IsValidIndex(ChunkIndex))
+        {
+            Placements.RemoveAt(ChunkIndex);
+        }
+
+        MarkLoadingScreenStateDirty();
+    }
+
+    TArray<FString> PendingChunks;
+    for (const ULevelStreamingDynamic* StreamedChunk : StreamedChunks)
+    {
+        if (IsChunkPending(StreamedChunk))
+        {
+            PendingChunks.Add(StreamedChunk->GetWorldAssetPackageName());
+        }
+    }
+
+    if (PendingChunks.Num() == 0)
+    {
+        GetWorld()->GetTimerManager().ClearTimer(ChunkStreamingTimerHandle);
+        MarkLoadingScreenStateDirty();
+        return;
+    }
+
+    const double StreamingSeconds = FPlatformTime::Seconds() - ChunkStreamingStartTime;
+    if (StreamingSeconds > URogueDeveloperSettings::Get()->ChunkStreamingTimeoutSeconds)
+    {
+        UE_LOG(LogRogueRunGenerator, Error, TEXT("URogueRunGeneratorSubsystem::UpdateChunkStreaming gave up waiting after %.1f s for %d chunks: %s."),
+            StreamingSeconds, PendingChunks.Num(), *FString::Join(PendingChunks, TEXT(", ")));
+
+        bChunkStreamingTimedOut = true;
+        GetWorld()->GetTimerManager().ClearTimer(ChunkStreamingTimerHandle);
+        MarkLoadingScreenStateDirty();
+    }
+}
+
+bool URogueRunGeneratorSubsystem::IsChunkPending(const ULevelStreamingDynamic* StreamedChunk)
+{
+    return IsValid(StreamedChunk) && StreamedChunk->GetLevelStreamingState() != ELevelStreamingState::FailedToLoad && !StreamedChunk->IsLevelVisible();
+}
+
+bool URogueRunGeneratorSubsystem::IsGeneratingRun() const
+{
+    FString Unused;
+    return ShouldShowLoadingScreen(Unused);
+}
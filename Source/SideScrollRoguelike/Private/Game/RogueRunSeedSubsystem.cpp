@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Game/RogueRunSeedSubsystem.h"
+
+#include "GenericPlatform/GenericPlatformCrashContext.h"
+#include "Hash/CityHash.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ScopeLock.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueRunSeedSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueRunSeed);
+
+namespace
+{
+    // SplitMix64 finalizer, spreads similar inputs across the whole 64-bit range
+    uint64 MixBits(uint64 Value)
+    {
+        Value = (Value ^ (Value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        Value = (Value ^ (Value >> 27)) * 0x94d049bb133111ebULL;
+        return Value ^ (Value >> 31);
+    }
+
+    // Hashes the stream name from its characters. FName hashes are not stable between sessions.
+    uint64 HashStreamName(FName StreamName)
+    {
+        TCHAR NameBuffer[NAME_SIZE];
+        const uint32 NameLength = StreamName.ToString(NameBuffer);
+        return CityHash64(reinterpret_cast<const char*>(NameBuffer), NameLength * sizeof(TCHAR));
+    }
+} // namespace
+
+void URogueRunSeedSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Allow reproducing a run from a crash report or bug ticket
+    uint64 CommandLineSeed = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("RogueRunSeed="), CommandLineSeed))
+    {
+        StartRun(int64(CommandLineSeed));
+    }
+    else
+    {
+        StartRandomRun();
+    }
+}
+
+void URogueRunSeedSubsystem::StartRun(int64 Seed)
+{
+    {
+        FScopeLock Lock(&StreamsLock);
+        RunSeed.store(uint64(Seed));
+        SharedStreams.Reset();
+    }
+
+    PublishRunSeed();
+    OnRunSeedChanged.Broadcast(uint64(Seed));
+}
+
+void URogueRunSeedSubsystem::StartRandomRun()
+{
+    const uint64 Entropy = FPlatformTime::Cycles64() ^ (uint64(FPlatformProcess::GetCurrentProcessId()) << 32);
+
+    // Keep the seed positive so it reads the same in Blueprint, logs and on the command line
+    StartRun(int64(MixBits(Entropy) & 0x7fffffffffffffffULL));
+}
+
+FRogueRandomStream URogueRunSeedSubsystem::MakeStream(FName StreamName) const
+{
+    const uint64 NameHash = HashStreamName(StreamName);
+    return FRogueRandomStream(MixBits(RunSeed.load() ^ NameHash), MixBits(NameHash));
+}
+
+int32 URogueRunSeedSubsystem::RandomIntegerInRange(FName StreamName, int32 Min, int32 Max)
+{
+    FScopeLock Lock(&StreamsLock);
+    return GetSharedStream(StreamName).RandRange(Min, Max);
+}
+
+float URogueRunSeedSubsystem::RandomFloatInRange(FName StreamName, float Min, float Max)
+{
+    FScopeLock Lock(&StreamsLock);
+    return GetSharedStream(StreamName).FRandRange(Min, Max);
+}
+
+bool URogueRunSeedSubsystem::RandomBoolWithProbability(FName StreamName, float Probability)
+{
+    FScopeLock Lock(&StreamsLock);
+    return GetSharedStream(StreamName).RandBool(Probability);
+}
+
+FRogueRandomStream& URogueRunSeedSubsystem::GetSharedStream(FName StreamName)
+{
+    if (FRogueRandomStream* Stream = SharedStreams.Find(StreamName))
+    {
+        return *Stream;
+    }
+
+    return SharedStreams.Add(StreamName, MakeStream(StreamName));
+}
+
+void URogueRunSeedSubsystem::PublishRunSeed() const
+{
+    const FString SeedString = FString::Printf(TEXT("%llu"), RunSeed.load());
+
+    // Shows up in the crash context of any crash that happens during this run
+    FGenericCrashContext::SetGameData(TEXT("RogueRunSeed"), SeedString);
+
+    UE_LOG(LogRogueRunSeed, Log, TEXT("Starting run with seed %s (replay with -RogueRunSeed=%s)"), *SeedString, *SeedString);
+}
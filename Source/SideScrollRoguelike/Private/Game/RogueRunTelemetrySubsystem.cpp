@@ -0,0 +1,328 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Game/RogueRunTelemetrySubsystem.h"
+
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "Engine/WorldInitializationValues.h"
+#include "EngineUtils.h"
+#include "Game/RogueGameState.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Trace/Trace.inl"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueRunTelemetrySubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueRunTelemetry);
+
+CSV_DEFINE_CATEGORY(RogueRun, true);
+
+UE_TRACE_CHANNEL_DEFINE(RogueRunChannel);
+
+UE_TRACE_EVENT_BEGIN(RogueRun, LevelStateChanged)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(int32, RunIndex)
+    UE_TRACE_EVENT_FIELD(uint8, LevelState)
+    UE_TRACE_EVENT_FIELD(double, RunSeconds)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(RogueRun, WorldSample)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(int32, RunIndex)
+    UE_TRACE_EVENT_FIELD(float, GameThreadMs)
+    UE_TRACE_EVENT_FIELD(int32, ActorCount)
+    UE_TRACE_EVENT_FIELD(int32, TickingActorCount)
+    UE_TRACE_EVENT_FIELD(int32, TickingComponentCount)
+    UE_TRACE_EVENT_FIELD(uint64, UsedPhysicalMemory)
+UE_TRACE_EVENT_END()
+
+namespace RogueTelemetryCVars
+{
+    static float SampleInterval = 1.0f;
+    static FAutoConsoleVariableRef CVarSampleInterval(
+        TEXT("Rogue.Telemetry.SampleInterval"),
+        SampleInterval,
+        TEXT("Seconds between samples of actor counts, ticking classes and memory during a run.\n"),
+        ECVF_Default);
+
+    static int32 NumTickClassesToRecord = 8;
+    static FAutoConsoleVariableRef CVarNumTickClassesToRecord(
+        TEXT("Rogue.Telemetry.NumTickClassesToRecord"),
+        NumTickClassesToRecord,
+        TEXT("How many of the classes with the most ticking instances are written to the CSV on every sample.\n"),
+        ECVF_Default);
+
+    static float HitchThresholdMs = 33.3f;
+    static FAutoConsoleVariableRef CVarHitchThresholdMs(
+        TEXT("Rogue.Telemetry.HitchThresholdMs"),
+        HitchThresholdMs,
+        TEXT("Game thread frames longer than this are counted as hitches in the run summary.\n"),
+        ECVF_Default);
+} // namespace RogueTelemetryCVars
+
+void URogueRunTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Bind to world initialization so that the recorder knows about the world state (BeginPlay)
+    PostWorldCreationHandle = FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &ThisClass::WorldInitialization);
+    PostWorldCleanupHandle  = FWorldDelegates::OnWorldCleanup.AddUObject(this, &ThisClass::WorldCleanup);
+}
+
+void URogueRunTelemetrySubsystem::Deinitialize()
+{
+    EndRun(TEXT("Shutdown"));
+
+    FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldCreationHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(PostWorldCleanupHandle);
+
+    Super::Deinitialize();
+}
+
+ETickableTickType URogueRunTelemetrySubsystem::GetTickableTickType() const
+{
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool URogueRunTelemetrySubsystem::IsTickable() const
+{
+    return bRunActive;
+}
+
+TStatId URogueRunTelemetrySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URogueRunTelemetrySubsystem, STATGROUP_Tickables);
+}
+
+UWorld* URogueRunTelemetrySubsystem::GetTickableGameObjectWorld() const
+{
+    return CurrentWorld.Get();
+}
+
+void URogueRunTelemetrySubsystem::WorldInitialization(UWorld* World, const FWorldInitializationValues IVS)
+{
+    if (!World || !World->IsGameWorld() || World->GetGameInstance() != GetGameInstance())
+    {
+        return;
+    }
+
+    CurrentWorld = World;
+    World->GameStateSetEvent.AddUObject(this, &ThisClass::GameStateSet);
+}
+
+void URogueRunTelemetrySubsystem::GameStateSet(AGameStateBase* GameState)
+{
+    if (ARogueGameState* RogueGameState = Cast<ARogueGameState>(GameState))
+    {
+        RogueGameState->OnLevelStateChanged.AddUniqueDynamic(this, &ThisClass::GameStateChanged);
+
+        // In case the state already moved on before the game state was set on the world
+        if (RogueGameState->GetLevelState() == ELevelState::Running)
+        {
+            GameStateChanged(ELevelState::Running);
+        }
+    }
+}
+
+void URogueRunTelemetrySubsystem::WorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (World && World == CurrentWorld.Get())
+    {
+        EndRun(TEXT("WorldCleanup"));
+        CurrentWorld.Reset();
+    }
+}
+
+void URogueRunTelemetrySubsystem::GameStateChanged(ELevelState NewLevelState)
+{
+    // Running is entered again after every pause, a run only starts once
+    if (NewLevelState == ELevelState::Running && !bRunActive)
+    {
+        BeginRun();
+    }
+
+    if (!bRunActive)
+    {
+        return;
+    }
+
+    const double RunSeconds = FPlatformTime::Seconds() - RunStats.StartTime;
+
+    UE_TRACE_LOG(RogueRun, LevelStateChanged, RogueRunChannel)
+        << LevelStateChanged.Cycle(FPlatformTime::Cycles64())
+        << LevelStateChanged.RunIndex(RunIndex)
+        << LevelStateChanged.LevelState(uint8(NewLevelState))
+        << LevelStateChanged.RunSeconds(RunSeconds);
+
+    RecordEvent(UEnum::GetDisplayValueAsText(NewLevelState).ToString());
+
+    switch (NewLevelState)
+    {
+        case ELevelState::GameOver:
+            EndRun(TEXT("GameOver"));
+            break;
+        case ELevelState::Victory:
+            EndRun(TEXT("Victory"));
+            break;
+        case ELevelState::Preload:
+        case ELevelState::Ready:
+            // The level was reset without finishing the run
+            EndRun(TEXT("Reset"));
+            break;
+        default:
+            break;
+    }
+}
+
+void URogueRunTelemetrySubsystem::BeginRun()
+{
+    ++RunIndex;
+    RunStats            = FRunStats();
+    RunStats.StartTime  = FPlatformTime::Seconds();
+    TimeUntilNextSample = 0.0f;
+    bRunActive          = true;
+
+    RecordEvent(TEXT("RunStart"));
+}
+
+void URogueRunTelemetrySubsystem::EndRun(const TCHAR* Reason)
+{
+    if (!bRunActive)
+    {
+        return;
+    }
+
+    bRunActive = false;
+
+    RecordEvent(FString::Printf(TEXT("RunEnd %s"), Reason));
+
+    const double RunSeconds        = FPlatformTime::Seconds() - RunStats.StartTime;
+    const double AverageGameThread = RunStats.Frames > 0 ? RunStats.TotalGameThreadMs / double(RunStats.Frames) : 0.0;
+
+    UE_LOG(LogRogueRunTelemetry, Log, TEXT("Run %d ended (%s) after %.1fs: %llu frames, game thread avg %.2fms peak %.2fms, %llu hitches over %.1fms, peak %d actors, peak %.1f MB used."),
+        RunIndex,
+        Reason,
+        RunSeconds,
+        RunStats.Frames,
+        AverageGameThread,
+        RunStats.PeakGameThreadMs,
+        RunStats.Hitches,
+        RogueTelemetryCVars::HitchThresholdMs,
+        RunStats.PeakActorCount,
+        double(RunStats.PeakUsedPhysical) / (1024.0 * 1024.0));
+}
+
+void URogueRunTelemetrySubsystem::Tick(float DeltaTime)
+{
+    // GGameThreadTime holds the game thread time of the previous frame
+    const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+    ++RunStats.Frames;
+    RunStats.TotalGameThreadMs += GameThreadMs;
+    RunStats.PeakGameThreadMs   = FMath::Max(RunStats.PeakGameThreadMs, GameThreadMs);
+
+    if (GameThreadMs > RogueTelemetryCVars::HitchThresholdMs)
+    {
+        ++RunStats.Hitches;
+        CSV_EVENT(RogueRun, TEXT("Hitch %.1fms"), GameThreadMs);
+    }
+
+    CSV_CUSTOM_STAT(RogueRun, GameThreadMs, float(GameThreadMs), ECsvCustomStatOp::Set);
+
+    // Sampling walks every actor, keep it off the per-frame path
+    TimeUntilNextSample -= DeltaTime;
+    if (TimeUntilNextSample <= 0.0f)
+    {
+        TimeUntilNextSample = FMath::Max(RogueTelemetryCVars::SampleInterval, 0.1f);
+        SampleWorld();
+    }
+}
+
+void URogueRunTelemetrySubsystem::SampleWorld()
+{
+    UWorld* World = CurrentWorld.Get();
+    if (!World)
+    {
+        return;
+    }
+
+    int32 ActorCount            = 0;
+    int32 TickingActorCount     = 0;
+    int32 TickingComponentCount = 0;
+    TMap<const UClass*, int32> TickingPerClass;
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AActor* Actor = *It;
+        ++ActorCount;
+
+        if (Actor->IsActorTickEnabled())
+        {
+            ++TickingActorCount;
+            ++TickingPerClass.FindOrAdd(Actor->GetClass());
+        }
+
+        for (const UActorComponent* Component : Actor->GetComponents())
+        {
+            if (Component && Component->IsComponentTickEnabled())
+            {
+                ++TickingComponentCount;
+                ++TickingPerClass.FindOrAdd(Component->GetClass());
+            }
+        }
+    }
+
+    const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+    RunStats.PeakActorCount   = FMath::Max(RunStats.PeakActorCount, ActorCount);
+    RunStats.PeakUsedPhysical = FMath::Max(RunStats.PeakUsedPhysical, UsedPhysical);
+
+    CSV_CUSTOM_STAT(RogueRun, ActorCount, ActorCount, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(RogueRun, TickingActors, TickingActorCount, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(RogueRun, TickingComponents, TickingComponentCount, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(RogueRun, UsedPhysicalMB, float(double(UsedPhysical) / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+
+#if CSV_PROFILER
+    // Only the classes with the most ticking instances, the CSV gets a column for every name ever written
+    if (FCsvProfiler::Get()->IsCapturing() && RogueTelemetryCVars::NumTickClassesToRecord > 0)
+    {
+        TickingPerClass.ValueSort(TGreater<int32>());
+
+        int32 NumRecorded = 0;
+        for (const TPair<const UClass*, int32>& Entry : TickingPerClass)
+        {
+            if (NumRecorded++ >= RogueTelemetryCVars::NumTickClassesToRecord)
+            {
+                break;
+            }
+
+            FName& StatName = TickStatNames.FindOrAdd(Entry.Key);
+            if (StatName.IsNone())
+            {
+                StatName = FName(*FString::Printf(TEXT("Ticking_%s"), *Entry.Key->GetName()));
+            }
+
+            FCsvProfiler::RecordCustomStat(StatName, CSV_CATEGORY_INDEX(RogueRun), Entry.Value, ECsvCustomStatOp::Set);
+        }
+    }
+#endif
+
+    UE_TRACE_LOG(RogueRun, WorldSample, RogueRunChannel)
+        << WorldSample.Cycle(FPlatformTime::Cycles64())
+        << WorldSample.RunIndex(RunIndex)
+        << WorldSample.GameThreadMs(float(FPlatformTime::ToMilliseconds(GGameThreadTime)))
+        << WorldSample.ActorCount(ActorCount)
+        << WorldSample.TickingActorCount(TickingActorCount)
+        << WorldSample.TickingComponentCount(TickingComponentCount)
+        << WorldSample.UsedPhysicalMemory(UsedPhysical);
+}
+
+void URogueRunTelemetrySubsystem::RecordEvent(const FString& EventName) const
+{
+    CSV_EVENT(RogueRun, TEXT("Run %d %s"), RunIndex, *EventName);
+    TRACE_BOOKMARK(TEXT("RogueRun %d %s"), RunIndex, *EventName);
+
+    UE_LOG(LogRogueRunTelemetry, Verbose, TEXT("Run %d %s"), RunIndex, *EventName);
+}
@@ -6,6 +6,7 @@
 #include "Components/CapsuleComponent.h"
 #include "Enemy/RogueEnemyCharacterBase.h"
 #include "Game/RogueGameState.h"
+#include "Game/RogueGameplayTags.h"
 #include "GameFramework/PlayerController.h"
 #include "Math/MathFwd.h"
 #include "Math/UnrealMathUtility.h"
@@ -14,6 +15,13 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RoguePlayerCharacter)
 
+ARoguePlayerCharacter::ARoguePlayerCharacter()
+{
+    EnemyBounceAudioEvent  = Tags::Audio_Event_Player_EnemyBounce;
+    HealthPickupAudioEvent = Tags::Audio_Event_Player_Pickup_Health;
+    SpeedPickupAudioEvent  = Tags::Audio_Event_Player_Pickup_Speed;
+}
+
 void ARoguePlayerCharacter::StopJumping()
 {
     // Inform our movement component that the jump input has stopped
@@ -116,6 +124,8 @@ void ARoguePlayerCharacter::JumpFromEnemyHurtBox()
         // Perform the jump on the character movement
         MoveComp->DoEnemyJump();
 
+        PostAudioEvent(EnemyBounceAudioEvent);
+
         // Broadcast to blueprint
         OnEnemyJump_BP();
     }
@@ -222,6 +232,7 @@ void ARoguePlayerCharacter::CharacterDeath()
 void ARoguePlayerCharacter::AddHitpoints(int32 PointsToAdd)
 {
     CurrentHitPoints += PointsToAdd;
+    PostAudioEvent(HealthPickupAudioEvent);
     OnHitpointsAdded.Broadcast();
 }
 
@@ -230,6 +241,8 @@ void ARoguePlayerCharacter::ActivateSpeedPowerup(float Duration, float MaxSpeedM
     // Update our powerup state bool
     bIsSpeedPowerupActive = true;
 
+    PostAudioEvent(SpeedPickupAudioEvent);
+
     if (URogueCharacterMovementComponent* MoveComp = GetRogueCharacterMovementComponent())
     {
         // Multiply both max acceleration and speed by our powerup multiplier
@@ -0,0 +1,193 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Settings/RogueSettingsPersistenceSubsystem.h"
+
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "GameFramework/GameUserSettings.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Settings/RogueDeveloperSettings.h"
+#include "Tasks/Task.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueSettingsPersistenceSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueSettingsPersistence);
+
+void URogueSettingsPersistenceSubsystem::Deinitialize()
+{
+    if (SaveTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+        SaveTickerHandle.Reset();
+    }
+
+    // Nothing may be lost on shutdown, so whatever is still dirty is written before the subsystem goes away
+    PendingWriteTask.Wait();
+    SaveGameUserSettings(true);
+    SaveInputSettings(true);
+
+    Super::Deinitialize();
+}
+
+void URogueSettingsPersistenceSubsystem::RequestSaveGameUserSettings()
+{
+    bGameUserSettingsDirty = true;
+    ScheduleSave();
+}
+
+void URogueSettingsPersistenceSubsystem::RequestSaveInputSettings(UEnhancedInputUserSettings* InputSettings)
+{
+    if (!InputSettings)
+    {
+        UE_LOG(LogRogueSettingsPersistence, Warning, TEXT("URogueSettingsPersistenceSubsystem::RequestSaveInputSettings InputSettings is nullptr."));
+        return;
+    }
+
+    DirtyInputSettings.AddUnique(InputSettings);
+    ScheduleSave();
+}
+
+void URogueSettingsPersistenceSubsystem::FlushPendingSaves()
+{
+    if (SaveTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+        SaveTickerHandle.Reset();
+    }
+
+    SaveGameUserSettings(false);
+    SaveInputSettings(false);
+}
+
+bool URogueSettingsPersistenceSubsystem::HasPendingSaves() const
+{
+    return bGameUserSettingsDirty || !DirtyInputSettings.IsEmpty();
+}
+
+void URogueSettingsPersistenceSubsystem::ScheduleSave()
+{
+    const URogueDeveloperSettings* DeveloperSettings = GetDefault<URogueDeveloperSettings>();
+    const double Now = FPlatformTime::Seconds();
+
+    if (SaveTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+        SaveTickerHandle.Reset();
+    }
+    else
+    {
+        FirstPendingRequestTime = Now;
+    }
+
+    // Restart the debounce window, but never wait past the maximum delay counted from the first unsaved request
+    const double TimeLeftToMaxDelay = DeveloperSettings->SettingsSaveMaxDelaySeconds - (Now - FirstPendingRequestTime);
+    const float Delay = FMath::Max(0.0f, static_cast<float>(FMath::Min<double>(DeveloperSettings->SettingsSaveDebounceSeconds, TimeLeftToMaxDelay)));
+
+    SaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::DebouncedSave), Delay);
+}
+
+bool URogueSettingsPersistenceSubsystem::DebouncedSave(float DeltaTime)
+{
+    SaveTickerHandle.Reset();
+
+    SaveGameUserSettings(false);
+    SaveInputSettings(false);
+
+    // One shot
+    return false;
+}
+
+void URogueSettingsPersistenceSubsystem::SaveGameUserSettings(bool bSynchronous)
+{
+    if (!bGameUserSettingsDirty)
+    {
+        return;
+    }
+
+    bGameUserSettingsDirty = false;
+
+    UGameUserSettings* Settings = GEngine ? GEngine->GetGameUserSettings() : nullptr;
+    if (!Settings)
+    {
+        UE_LOG(LogRogueSettingsPersistence, Error, TEXT("URogueSettingsPersistenceSubsystem::SaveGameUserSettings GameUserSettings is nullptr."));
+        return;
+    }
+
+    if (bSynchronous || !GConfig)
+    {
+        Settings->SaveSettings();
+        return;
+    }
+
+    // Let the settings update the config cache without touching the disk, then write a copy of the ini on a background task
+    GConfig->DisableFileOperations();
+    Settings->SaveSettings();
+    GConfig->EnableFileOperations();
+
+    FConfigFile* ConfigFile = GConfig->FindConfigFile(GGameUserSettingsIni);
+    if (!ConfigFile)
+    {
+        UE_LOG(LogRogueSettingsPersistence, Warning, TEXT("URogueSettingsPersistenceSubsystem::SaveGameUserSettings could not find %s in the config cache, saving on the game thread."), *GGameUserSettingsIni);
+        Settings->SaveSettings();
+        return;
+    }
+
+    // The ini text is built here, the config cache is not thread safe. The worker only writes the finished string.
+    FString Text;
+    if (!ConfigFile->WriteToString(Text, GGameUserSettingsIni))
+    {
+        UE_LOG(LogRogueSettingsPersistence, Warning, TEXT("URogueSettingsPersistenceSubsystem::SaveGameUserSettings could not build %s, saving on the game thread."), *GGameUserSettingsIni);
+        Settings->SaveSettings();
+        return;
+    }
+
+    const FString Filename = GGameUserSettingsIni;
+
+    // The text is written below, so the config cache must not write the same changes again on its next flush
+    ConfigFile->Dirty = false;
+
+    // Writes are chained so an older text can never land after a newer one
+    PendingWriteTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Text = MoveTemp(Text), Filename]()
+    {
+        const double StartTime = FPlatformTime::Seconds();
+
+        if (FFileHelper::SaveStringToFile(Text, *Filename))
+        {
+            UE_LOG(LogRogueSettingsPersistence, Verbose, TEXT("URogueSettingsPersistenceSubsystem wrote %s in %.2f ms."), *Filename, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+            return;
+        }
+
+        UE_LOG(LogRogueSettingsPersistence, Error, TEXT("URogueSettingsPersistenceSubsystem failed to write %s, leaving it to the next config flush."), *Filename);
+
+        // Mark the cache dirty again so the change is not lost, the config cache belongs to the game thread
+        AsyncTask(ENamedThreads::GameThread, [Filename]()
+        {
+            if (FConfigFile* ConfigFile = GConfig ? GConfig->FindConfigFile(Filename) : nullptr)
+            {
+                ConfigFile->Dirty = true;
+            }
+        });
+    }, UE::Tasks::Prerequisites(PendingWriteTask), UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void URogueSettingsPersistenceSubsystem::SaveInputSettings(bool bSynchronous)
+{
+    for (const TWeakObjectPtr<UEnhancedInputUserSettings>& WeakInputSettings : DirtyInputSettings)
+    {
+        if (UEnhancedInputUserSettings* InputSettings = WeakInputSettings.Get())
+        {
+            if (bSynchronous)
+            {
+                InputSettings->SaveSettings();
+            }
+            else
+            {
+                InputSettings->AsyncSaveSettings();
+            }
+        }
+    }
+
+    DirtyInputSettings.Reset();
+}
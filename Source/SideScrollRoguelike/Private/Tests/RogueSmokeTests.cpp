@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Audio/RogueAudioSubsystem.h"
+#include "Character/RogueCharacterBase.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Settings/RogueGameUserSettings.h"
+#include "Slate/WidgetRenderer.h"
+#include "UI/RogueGameLayout.h"
+#include "UI/RogueHUD.h"
+#include "UI/RogueHUDModel.h"
+#include "UI/RogueHUDValueWidget.h"
+#include "UI/RogueRebindTransaction.h"
+#include "UObject/UObjectIterator.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Smoke tests running the benchmarks against the game world that is currently playing. They need no map of their own,
+ * run them headless from a game launched on any level:
+ *     -game -nullrhi -nosound -ExecCmds="Automation RunTests Rogue; Quit"
+ */
+namespace RogueSmokeTests
+{
+    // Returns the game world that has begun play, or nullptr after logging an error on the test
+    UWorld* FindGameWorld(FAutomationTestBase& Test)
+    {
+        if (GEngine)
+        {
+            for (const FWorldContext& Context : GEngine->GetWorldContexts())
+            {
+                UWorld* World = Context.World();
+                if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && World && World->HasBegunPlay())
+                {
+                    return World;
+                }
+            }
+        }
+
+        Test.AddError(TEXT("No game world is playing. Run the Rogue smoke tests from a running game, e.g. -game -nullrhi -ExecCmds=\"Automation RunTests Rogue\"."));
+        return nullptr;
+    }
+
+    // Returns the current key of every mapping in the active key profile of the local player
+    TMap<TPair<FName, EPlayerMappableKeySlot>, FKey> CaptureKeyBindings(const ULocalPlayer* LocalPlayer)
+    {
+        TMap<TPair<FName, EPlayerMappableKeySlot>, FKey> Bindings;
+
+        const UEnhancedInputLocalPlayerSubsystem* System = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer);
+        const UEnhancedInputUserSettings* UserSettings   = System ? System->GetUserSettings() : nullptr;
+        if (const UEnhancedPlayerMappableKeyProfile* Profile = UserSettings ? UserSettings->GetActiveKeyProfile() : nullptr)
+        {
+            for (const TPair<FName, FKeyMappingRow>& Row : Profile->GetPlayerMappingRows())
+            {
+                for (const FPlayerKeyMapping& Mapping : Row.Value.Mappings)
+                {
+                    Bindings.Add({Mapping.GetMappingName(), Mapping.GetSlot()}, Mapping.GetCurrentKey());
+                }
+            }
+        }
+
+        return Bindings;
+    }
+} // namespace RogueSmokeTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRogueAudioBenchmarkTest, "Rogue.Audio.Benchmark", EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FRogueAudioBenchmarkTest::RunTest(const FString& Parameters)
+{
+    const UWorld* World = RogueSmokeTests::FindGameWorld(*this);
+    if (!World)
+    {
+        return false;
+    }
+
+    URogueAudioSubsystem* AudioSubsystem = World->GetGameInstance()->GetSubsystem<URogueAudioSubsystem>();
+    const URogueGameUserSettings* GameSettings = GEngine ? Cast<URogueGameUserSettings>(GEngine->GetGameUserSettings()) : nullptr;
+    if (!TestNotNull(TEXT("Audio subsystem"), AudioSubsystem) || !TestNotNull(TEXT("Rogue game user settings"), GameSettings))
+    {
+        return false;
+    }
+
+    const float MainVolume  = GameSettings->MainVolume;
+    const float MusicVolume = GameSettings->MusicVolume;
+    const float SFXVolume   = GameSettings->SFXVolume;
+
+    TestTrue(TEXT("Benchmark ran"), AudioSubsystem->RunAudioBenchmark(20));
+
+    // The benchmark drags every slider, the player's volumes have to be back afterwards
+    TestEqual(TEXT("Main volume restored"), GameSettings->MainVolume, MainVolume);
+    TestEqual(TEXT("Music volume restored"), GameSettings->MusicVolume, MusicVolume);
+    TestEqual(TEXT("SFX volume restored"), GameSettings->SFXVolume, SFXVolume);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRogueRebindBenchmarkTest, "Rogue.Input.RebindBenchmark", EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FRogueRebindBenchmarkTest::RunTest(const FString& Parameters)
+{
+    const UWorld* World = RogueSmokeTests::FindGameWorld(*this);
+    ULocalPlayer* LocalPlayer = World && GEngine ? GEngine->GetFirstGamePlayer(World) : nullptr;
+    if (!TestNotNull(TEXT("Local player"), LocalPlayer))
+    {
+        return false;
+    }
+
+    const TMap<TPair<FName, EPlayerMappableKeySlot>, FKey> BindingsBefore = RogueSmokeTests::CaptureKeyBindings(LocalPlayer);
+
+    URogueRebindTransaction::FResetBenchmarkResult Result;
+    if (!TestTrue(TEXT("Benchmark ran"), URogueRebindTransaction::RunResetBenchmark(LocalPlayer, 50, &Result)))
+    {
+        return false;
+    }
+
+    // The transaction has to get away with a single rebuild where the per action path needs one each
+    TestTrue(TEXT("Transaction reset the actions"), Result.TransactionChanges > 0);
+    TestEqual(TEXT("Transaction rebuild requests"), Result.TransactionRebuilds, 1);
+    TestTrue(TEXT("Fewer rebuilds than per action"), Result.TransactionRebuilds < Result.PerActionRebuilds);
+
+    // The benchmark scrambles the bindings, the player's keys have to be back afterwards
+    TestTrue(TEXT("Key bindings restored"), RogueSmokeTests::CaptureKeyBindings(LocalPlayer).OrderIndependentCompareEqual(BindingsBefore));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRogueHUDInvalidationTest, "Rogue.UI.HUDInvalidation", EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FRogueHUDInvalidationTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = RogueSmokeTests::FindGameWorld(*this);
+    APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    const ARogueHUD* RogueHUD           = PlayerController ? PlayerController->GetHUD<ARogueHUD>() : nullptr;
+    const URogueHUDModel* Model         = RogueHUD ? RogueHUD->GetHUDModel() : nullptr;
+    if (!TestNotNull(TEXT("HUD model"), Model))
+    {
+        return false;
+    }
+
+    // The HUD binds before the pawn begins play, the hit points have to be right from the first broadcast
+    if (const ARogueCharacterBase* Character = Cast<ARogueCharacterBase>(PlayerController->GetPawn()))
+    {
+        TestEqual(TEXT("HUD hit points"), Model->GetValue(ERogueHUDValue::HitPoints), Character->GetCurrentHitPoints());
+        TestTrue(TEXT("HUD hit points set before the first hit"), Character->IsDead() || Model->GetValue(ERogueHUDValue::HitPoints) > 0);
+    }
+
+    TArray<TSharedRef<SWidget>> ValueWidgets;
+    TArray<URogueHUDValueWidget*> ValueWidgetObjects;
+    for (TObjectIterator<URogueHUDValueWidget> It; It; ++It)
+    {
+        if (It->GetWorld() == World && It->GetCachedWidget().IsValid())
+        {
+            ValueWidgets.Add(It->GetCachedWidget().ToSharedRef());
+            ValueWidgetObjects.Add(*It);
+        }
+    }
+
+    if (ValueWidgets.IsEmpty())
+    {
+        AddWarning(TEXT("No HUD value widget is on screen, nothing to compare."));
+        return true;
+    }
+
+    // Paint needs something to render into, which a -nullrhi run does not have
+    const FVector2D DrawSize(1920.0f, 1080.0f);
+    UTextureRenderTarget2D* RenderTarget = nullptr;
+    TUniquePtr<FWidgetRenderer> WidgetRenderer;
+    if (FApp::CanEverRender())
+    {
+        RenderTarget = NewObject<UTextureRenderTarget2D>(GetTransientPackage());
+        RenderTarget->InitAutoFormat(DrawSize.X, DrawSize.Y);
+        WidgetRenderer = MakeUnique<FWidgetRenderer>(true);
+    }
+
+    // Prepass and paint cost of all value widgets over a number of frames without value changes
+    const auto MeasureFrames = [&ValueWidgets, &ValueWidgetObjects, &WidgetRenderer, RenderTarget, DrawSize](bool bCaching, double& OutPrepassMs, double& OutPaintMs)
+    {
+        for (URogueHUDValueWidget* ValueWidget : ValueWidgetObjects)
+        {
+            ValueWidget->SetCachingEnabled(bCaching);
+        }
+
+        constexpr int32 NumFrames = 100;
+        OutPrepassMs              = 0.0;
+        OutPaintMs                = 0.0;
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            for (const TSharedRef<SWidget>& ValueWidget : ValueWidgets)
+            {
+                const double PrepassStartTime = FPlatformTime::Seconds();
+                ValueWidget->SlatePrepass(1.0f);
+                OutPrepassMs += (FPlatformTime::Seconds() - PrepassStartTime) * 1000.0;
+
+                if (WidgetRenderer)
+                {
+                    const double PaintStartTime = FPlatformTime::Seconds();
+                    WidgetRenderer->DrawWidget(RenderTarget, ValueWidget, DrawSize, 0.0f);
+                    OutPaintMs += (FPlatformTime::Seconds() - PaintStartTime) * 1000.0;
+                }
+            }
+        }
+    };
+
+    double CachedPrepassMs   = 0.0;
+    double CachedPaintMs     = 0.0;
+    double UncachedPrepassMs = 0.0;
+    double UncachedPaintMs   = 0.0;
+    MeasureFrames(false, UncachedPrepassMs, UncachedPaintMs);
+    MeasureFrames(true, CachedPrepassMs, CachedPaintMs);
+
+    // Put the caching back the way Rogue.UI.HUDInvalidation has it
+    const IConsoleVariable* HUDInvalidation = IConsoleManager::Get().FindConsoleVariable(TEXT("Rogue.UI.HUDInvalidation"));
+    for (URogueHUDValueWidget* ValueWidget : ValueWidgetObjects)
+    {
+        ValueWidget->SetCachingEnabled(!HUDInvalidation || HUDInvalidation->GetBool());
+    }
+
+    AddInfo(FString::Printf(TEXT("%d HUD value widgets, 100 frames. Prepass: %.3f ms without caching, %.3f ms with caching."), ValueWidgets.Num(), UncachedPrepassMs, CachedPrepassMs));
+    if (WidgetRenderer)
+    {
+        AddInfo(FString::Printf(TEXT("Paint: %.3f ms without caching, %.3f ms with caching."), UncachedPaintMs, CachedPaintMs));
+    }
+    else
+    {
+        AddInfo(TEXT("Paint skipped without rendering."));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRogueUIBenchmarkTest, "Rogue.UI.Benchmark", EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FRogueUIBenchmarkTest::RunTest(const FString& Parameters)
+{
+    UWorld* World = RogueSmokeTests::FindGameWorld(*this);
+    if (!World)
+    {
+        return false;
+    }
+
+    URogueGameLayout::FFrameCostBenchmarkResult Result;
+    if (!TestTrue(TEXT("Benchmark ran"), URogueGameLayout::RunFrameCostBenchmark(World->GetFirstPlayerController(), 20, 20, &Result)))
+    {
+        return false;
+    }
+
+    // Every popped screen has to leave the layer, so each pooled push after the first gets the same instance back while
+    // the cold pushes it is compared against never do
+    TestEqual(TEXT("Popped screens left on the layer"), Result.ScreensLeftOnLayer, 0);
+    TestEqual(TEXT("Pooled pushes reusing the screen"), Result.PooledPushesReused, Result.Iterations - 1);
+    TestEqual(TEXT("Cold pushes reusing the screen"), Result.ColdPushesReused, 0);
+    TestTrue(TEXT("Input selectors initialized from the key profile"), Result.SelectorsInitialized > 0);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -1,11 +1,44 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "UI/RogueGameLayout.h"
+#include "CommonActivatableWidget.h"
+#include "Components/VerticalBox.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/AssetManager.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "Game/RogueGameplayTags.h"
+#include "GameFramework/PlayerController.h"
 #include "GameplayTagContainer.h"
+#include "HAL/IConsoleManager.h"
+#include "Settings/RogueDeveloperSettings.h"
+#include "Slate/WidgetRenderer.h"
+#include "UObject/UObjectArray.h"
+#include "UI/RogueHUD.h"
+#include "UI/RogueInputSelector.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RogueGameLayout)
 
+DEFINE_LOG_CATEGORY(LogRogueGameLayout);
+
+DECLARE_CYCLE_STAT(TEXT("Pop Layers"), STAT_RogueUI_PopLayers, STATGROUP_RogueUI);
+DECLARE_CYCLE_STAT(TEXT("Clear Layers"), STAT_RogueUI_ClearLayers, STATGROUP_RogueUI);
+
+namespace RogueGameLayoutCommands
+{
+    static FAutoConsoleCommandWithWorldAndArgs Benchmark(
+        TEXT("Rogue.UI.Benchmark"),
+        TEXT("Pushes and pops the benchmark screen on the root layout, once reused from the layer's widget pool and once freshly created, builds a list of input selectors for the key profile and logs the cost and UObjects created by each operation. Usage: Rogue.UI.Benchmark [Iterations=50] [NumSelectors=20]. Runs headless with -nullrhi, paint is skipped when nothing can render."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            URogueGameLayout::RunFrameCostBenchmark(World ? World->GetFirstPlayerController() : nullptr, Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 20);
+        }));
+}
+
 void URogueGameLayout::RegisterLayer(FGameplayTag LayerName, UCommonActivatableWidgetContainerBase* LayerWidget)
 {
     if (!IsDesignTime())
@@ -21,6 +54,25 @@ UCommonActivatableWidgetContainerBase* URogueGameLayout::GetLayerWidget(FGamepla
 
 void URogueGameLayout::FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* ActivatableWidget)
 {
+    if (!ActivatableWidget)
+    {
+        return;
+    }
+
+    FGameplayTag LayerName;
+    if (WidgetLayers.RemoveAndCopyValue(ActivatableWidget, LayerName))
+    {
+        // The widget may have left the layer on its own since it was pushed
+        UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName);
+        if (Layer && Layer->GetWidgetList().Contains(ActivatableWidget))
+        {
+            Layer->RemoveWidget(*ActivatableWidget);
+        }
+
+        return;
+    }
+
+    // Widgets added to a layer without going through the layout are not indexed
     for (const auto& LayerPair : Layers)
     {
         if (!LayerPair.Value->GetWidgetList().Contains(ActivatableWidget))
@@ -31,4 +83,285 @@ void URogueGameLayout::FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* Ac
         LayerPair.Value->RemoveWidget(*ActivatableWidget);
         break;
     }
-}
\ No newline at end of file
+}
+
+void URogueGameLayout::PopLayers(const FGameplayTagContainer& LayerNames)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueUI_PopLayers);
+
+    for (const FGameplayTag& LayerName : LayerNames)
+    {
+        UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName);
+        if (UCommonActivatableWidget* ActiveWidget = Layer ? Layer->GetActiveWidget() : nullptr)
+        {
+            WidgetLayers.Remove(ActiveWidget);
+            Layer->RemoveWidget(*ActiveWidget);
+        }
+    }
+}
+
+void URogueGameLayout::ClearLayers(const FGameplayTagContainer& LayerNames)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RogueUI_ClearLayers);
+
+    for (const FGameplayTag& LayerName : LayerNames)
+    {
+        UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName);
+        if (!Layer)
+        {
+            continue;
+        }
+
+        for (UCommonActivatableWidget* Widget : Layer->GetWidgetList())
+        {
+            WidgetLayers.Remove(Widget);
+        }
+
+        Layer->ClearWidgets();
+    }
+}
+
+TSharedPtr<FStreamableHandle> URogueGameLayout::PushWidgetToLayerStackAsync(FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass, TFunction<void(UCommonActivatableWidget*)> OnPushed)
+{
+    if (UClass* LoadedClass = WidgetClass.Get())
+    {
+        OnPushed(PushWidgetToLayerStack(LayerName, LoadedClass));
+        return nullptr;
+    }
+
+    if (WidgetClass.IsNull())
+    {
+        UE_LOG(LogRogueGameLayout, Warning, TEXT("URogueGameLayout::PushWidgetToLayerStackAsync no widget class for %s."), *LayerName.ToString());
+        OnPushed(nullptr);
+        return nullptr;
+    }
+
+    UE_LOG(LogRogueGameLayout, Log, TEXT("URogueGameLayout::PushWidgetToLayerStackAsync %s was not preloaded, streaming it in."), *WidgetClass.ToString());
+
+    return UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClass.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this, [this, LayerName, WidgetClass, OnPushed = MoveTemp(OnPushed)]()
+    {
+        UClass* LoadedClass = WidgetClass.Get();
+        if (!LoadedClass)
+        {
+            UE_LOG(LogRogueGameLayout, Warning, TEXT("URogueGameLayout::PushWidgetToLayerStackAsync failed to load %s."), *WidgetClass.ToString());
+        }
+
+        OnPushed(LoadedClass ? PushWidgetToLayerStack(LayerName, LoadedClass) : nullptr);
+    }), FStreamableManager::AsyncLoadHighPriority);
+}
+
+void URogueGameLayout::IndexWidget(FGameplayTag LayerName, UCommonActivatableWidget& Widget)
+{
+    WidgetLayers.Add(&Widget, LayerName);
+
+    // Compacting once the index has doubled keeps pushes constant time on average
+    if (WidgetLayers.Num() >= CompactWidgetIndexAt)
+    {
+        CompactWidgetIndex();
+        CompactWidgetIndexAt = FMath::Max(32, WidgetLayers.Num() * 2);
+    }
+}
+
+void URogueGameLayout::CompactWidgetIndex()
+{
+    for (auto It = WidgetLayers.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool URogueGameLayout::RunFrameCostBenchmark(APlayerController* PlayerController, int32 Iterations, int32 NumSelectors, FFrameCostBenchmarkResult* OutResult)
+{
+    ARogueHUD* RogueHUD          = PlayerController ? PlayerController->GetHUD<ARogueHUD>() : nullptr;
+    URogueGameLayout* RootLayout = RogueHUD ? RogueHUD->GetRootLayoutWidget().Get() : nullptr;
+    if (!RootLayout)
+    {
+        UE_LOG(LogRogueGameLayout, Warning, TEXT("URogueGameLayout::RunFrameCostBenchmark needs a local player with a Rogue HUD and root layout."));
+        return false;
+    }
+
+    const URogueDeveloperSettings* DeveloperSettings = GetDefault<URogueDeveloperSettings>();
+    UClass* ScreenClass                              = DeveloperSettings->UIBenchmarkScreenClass.LoadSynchronous();
+    UClass* SelectorClass                            = DeveloperSettings->UIBenchmarkInputSelectorClass.LoadSynchronous();
+    const FGameplayTag LayerName                     = DeveloperSettings->UIBenchmarkLayerName.IsValid() ? DeveloperSettings->UIBenchmarkLayerName : Tags::UI_Layer_Menu;
+    UCommonActivatableWidgetContainerBase* Layer     = RootLayout->GetLayerWidget(LayerName);
+    if (!ScreenClass || !SelectorClass || !Layer)
+    {
+        UE_LOG(LogRogueGameLayout, Warning, TEXT("URogueGameLayout::RunFrameCostBenchmark needs the benchmark screen and input selector classes in the developer settings and a %s layer."), *LayerName.ToString());
+        return false;
+    }
+
+    // The selectors show the actions of the player's key profile, like the settings screen does
+    const UEnhancedInputLocalPlayerSubsystem* InputSystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
+    const UEnhancedInputUserSettings* InputSettings       = InputSystem ? InputSystem->GetUserSettings() : nullptr;
+    const UEnhancedPlayerMappableKeyProfile* KeyProfile   = InputSettings ? InputSettings->GetActiveKeyProfile() : nullptr;
+    TArray<const FPlayerKeyMapping*> KeyMappings;
+    if (KeyProfile)
+    {
+        for (const TPair<FName, FKeyMappingRow>& Row : KeyProfile->GetPlayerMappingRows())
+        {
+            for (const FPlayerKeyMapping& Mapping : Row.Value.Mappings)
+            {
+                KeyMappings.Add(&Mapping);
+            }
+        }
+    }
+
+    if (KeyMappings.IsEmpty())
+    {
+        UE_LOG(LogRogueGameLayout, Warning, TEXT("URogueGameLayout::RunFrameCostBenchmark needs a key profile with mappings for the input selectors."));
+        return false;
+    }
+
+    Iterations   = FMath::Max(Iterations, 1);
+    NumSelectors = FMath::Max(NumSelectors, 1);
+
+    // Cost and UObjects created by one kind of operation over all iterations
+    struct FBenchmarkOperation
+    {
+        const TCHAR* Name  = nullptr;
+        uint64 TotalCycles = 0;
+        uint64 MaxCycles   = 0;
+        int64 TotalObjects = 0;
+        int32 Count        = 0;
+
+        void Measure(TFunctionRef<void()> Work)
+        {
+            const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+            const uint64 StartCycles  = FPlatformTime::Cycles64();
+            Work();
+            const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+            TotalCycles += Cycles;
+            MaxCycles = FMath::Max(MaxCycles, Cycles);
+            TotalObjects += GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+            ++Count;
+        }
+    };
+
+    FBenchmarkOperation PooledPush        = {TEXT("Push screen, layer pool")};
+    FBenchmarkOperation ColdPush          = {TEXT("Push screen, CreateWidget")};
+    FBenchmarkOperation ScreenPrepass     = {TEXT("Screen prepass")};
+    FBenchmarkOperation Pop               = {TEXT("Pop screen")};
+    FBenchmarkOperation ConstructSelector = {TEXT("Construct input selector")};
+    FBenchmarkOperation SelectorsPrepass  = {TEXT("Selector list prepass")};
+    FBenchmarkOperation SelectorsPaint    = {TEXT("Selector list paint")};
+    const FBenchmarkOperation* const Operations[] = {&PooledPush, &ColdPush, &ScreenPrepass, &Pop, &ConstructSelector, &SelectorsPrepass, &SelectorsPaint};
+
+    FFrameCostBenchmarkResult Result;
+    Result.Iterations   = Iterations;
+    Result.NumSelectors = NumSelectors;
+
+    // Paint needs something to render into, which a -nullrhi run does not have
+    const FVector2D DrawSize(1920.0f, 1080.0f);
+    UTextureRenderTarget2D* RenderTarget = nullptr;
+    TUniquePtr<FWidgetRenderer> WidgetRenderer;
+    if (FApp::CanEverRender())
+    {
+        RenderTarget = NewObject<UTextureRenderTarget2D>(GetTransientPackage());
+        RenderTarget->InitAutoFormat(DrawSize.X, DrawSize.Y);
+        WidgetRenderer = MakeUnique<FWidgetRenderer>(true);
+    }
+
+    // Nothing ticks between iterations, so the layer has to let go of a popped screen right away instead of after its
+    // outro transition. Otherwise the screen stays on the layer and its pool can never hand it out again.
+    const float TransitionDuration = Layer->GetTransitionDuration();
+    Layer->SetTransitionDuration(0.0f);
+
+    UVerticalBox* SelectorList = NewObject<UVerticalBox>(RootLayout);
+
+    UCommonActivatableWidget* PreviousPooledScreen = nullptr;
+    UCommonActivatableWidget* PreviousColdScreen   = nullptr;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        // The same push and pop, once through the layer, which reuses the screen it released last time, and once with a
+        // screen created for the push. A widget added as an instance is not owned by the layer's pool and is dropped on removal.
+        for (const bool bPooled : {true, false})
+        {
+            UCommonActivatableWidget* Screen = nullptr;
+            if (bPooled)
+            {
+                PooledPush.Measure([RootLayout, LayerName, ScreenClass, &Screen]() { Screen = RootLayout->PushWidgetToLayerStack(LayerName, ScreenClass); });
+            }
+            else
+            {
+                ColdPush.Measure([RootLayout, Layer, ScreenClass, &Screen]()
+                {
+                    Screen = CreateWidget<UCommonActivatableWidget>(RootLayout, ScreenClass);
+                    if (Screen)
+                    {
+                        Layer->AddWidgetInstance(*Screen);
+                    }
+                });
+            }
+
+            if (!Screen)
+            {
+                continue;
+            }
+
+            UCommonActivatableWidget*& PreviousScreen = bPooled ? PreviousPooledScreen : PreviousColdScreen;
+            (bPooled ? Result.PooledPushesReused : Result.ColdPushesReused) += Screen == PreviousScreen ? 1 : 0;
+            PreviousScreen = Screen;
+
+            ScreenPrepass.Measure([Screen]() { Screen->TakeWidget()->SlatePrepass(1.0f); });
+            Pop.Measure([RootLayout, Screen]() { RootLayout->FindAndRemoveWidgetFromLayer(Screen); });
+
+            Result.ScreensLeftOnLayer += Layer->GetWidgetList().Contains(Screen) ? 1 : 0;
+        }
+
+        // A settings screen worth of selectors, built from scratch and filled with the key profile like the menu does when it opens
+        SelectorList->ClearChildren();
+        for (int32 Index = 0; Index < NumSelectors; ++Index)
+        {
+            const FPlayerKeyMapping& Mapping = *KeyMappings[Index % KeyMappings.Num()];
+            ConstructSelector.Measure([PlayerController, SelectorClass, SelectorList, KeyProfile, &Mapping]()
+            {
+                URogueInputSelector* Selector = CreateWidget<URogueInputSelector>(PlayerController, SelectorClass);
+                Selector->InitializeInputData(KeyProfile, Mapping);
+                SelectorList->AddChildToVerticalBox(Selector);
+            });
+        }
+
+        const TSharedRef<SWidget> SelectorListWidget = SelectorList->TakeWidget();
+        SelectorsPrepass.Measure([&SelectorListWidget]() { SelectorListWidget->SlatePrepass(1.0f); });
+
+        if (WidgetRenderer)
+        {
+            SelectorsPaint.Measure([&WidgetRenderer, RenderTarget, &SelectorListWidget, DrawSize]() { WidgetRenderer->DrawWidget(RenderTarget, SelectorListWidget, DrawSize, 0.0f); });
+        }
+    }
+
+    for (int32 Index = 0; Index < SelectorList->GetChildrenCount(); ++Index)
+    {
+        const URogueInputSelector* Selector = Cast<URogueInputSelector>(SelectorList->GetChildAt(Index));
+        Result.SelectorsInitialized += Selector && Selector->GetActionMappingName() != NAME_None ? 1 : 0;
+    }
+
+    SelectorList->ClearChildren();
+    Layer->SetTransitionDuration(TransitionDuration);
+
+    UE_LOG(LogRogueGameLayout, Log, TEXT("URogueGameLayout UI benchmark, %d iterations, %d input selectors%s:"), Iterations, NumSelectors, WidgetRenderer ? TEXT("") : TEXT(", paint skipped without rendering"));
+
+    for (const FBenchmarkOperation* Operation : Operations)
+    {
+        const int32 Count        = FMath::Max(Operation->Count, 1);
+        const double AverageUs   = FPlatformTime::ToMilliseconds64(Operation->TotalCycles) * 1000.0 / Count;
+        const double MaxUs       = FPlatformTime::ToMilliseconds64(Operation->MaxCycles) * 1000.0;
+        const double AverageObjs = double(Operation->TotalObjects) / Count;
+        UE_LOG(LogRogueGameLayout, Log, TEXT("    %-26s %6d calls, avg %8.2f us, max %8.2f us, avg %8.2f UObjects created"), Operation->Name, Operation->Count, AverageUs, MaxUs, AverageObjs);
+    }
+
+    UE_LOG(LogRogueGameLayout, Log, TEXT("    Layer pool pushes reused the previous screen %d of %d times, CreateWidget pushes %d times, %d popped screens stayed on the layer, %d of %d selectors initialized."),
+        Result.PooledPushesReused, Iterations, Result.ColdPushesReused, Result.ScreensLeftOnLayer, Result.SelectorsInitialized, NumSelectors);
+
+    if (OutResult)
+    {
+        *OutResult = Result;
+    }
+
+    return true;
+}
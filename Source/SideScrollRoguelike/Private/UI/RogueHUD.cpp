@@ -4,6 +4,7 @@
 
 #include "CommonActivatableWidget.h"
 #include "UI/RogueGameLayout.h"
+#include "UI/RogueHUDModel.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RogueHUD)
 
@@ -17,8 +18,27 @@ void ARogueHUD::BeginPlay()
     // Add the widget to the player's screen as the root widget
     RootLayoutWidget->AddToPlayerScreen();
 
-    // Load and add the first widget on the specified layer
+    // The HUD widgets bind to the model when they are constructed, so it has to exist before the first push
+    HUDModel = NewObject<URogueHUDModel>(this);
+    HUDModel->Initialize(GetOwningPlayerController());
+
+    // Add the first widget on the specified layer, streaming it in first if the UI preloader has not loaded it yet
     // Subsequent screens can just be stacked upon the root per layer using PushWidgetToLayerStack
-    TSubclassOf<UCommonActivatableWidget> HUDWidgetClass = DefaultWidgetClass.LoadSynchronous();
-    DefaultWidget                                        = RootLayoutWidget->PushWidgetToLayerStack(DefaultLayerName, HUDWidgetClass);
+    RootLayoutWidget->PushWidgetToLayerStackAsync(DefaultLayerName, DefaultWidgetClass, [WeakThis = TWeakObjectPtr<ARogueHUD>(this)](UCommonActivatableWidget* Widget)
+    {
+        if (ARogueHUD* RogueHUD = WeakThis.Get())
+        {
+            RogueHUD->DefaultWidget = Widget;
+        }
+    });
+}
+
+void ARogueHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (HUDModel)
+    {
+        HUDModel->Deinitialize();
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
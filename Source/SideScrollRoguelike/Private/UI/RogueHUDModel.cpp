@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UI/RogueHUDModel.h"
+
+#include "Character/RogueCharacterBase.h"
+#include "Engine/World.h"
+#include "Game/RogueGameState.h"
+#include "GameFramework/PlayerController.h"
+#include "Player/RoguePlayerCharacter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueHUDModel)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Value Changes"), STAT_RogueUIHUDValueChanges, STATGROUP_RogueUI);
+
+void URogueHUDModel::Initialize(APlayerController* PlayerController)
+{
+    if (!PlayerController)
+    {
+        return;
+    }
+
+    OwningPlayerController = PlayerController;
+    NewPawnHandle          = PlayerController->GetOnNewPawnNotifier().AddUObject(this, &ThisClass::PawnChanged);
+    PawnChanged(PlayerController->GetPawn());
+
+    // The game state is spawned before the player controller, so it is already around when the HUD begins play
+    if (ARogueGameState* GameState = PlayerController->GetWorld()->GetGameState<ARogueGameState>())
+    {
+        RogueGameState         = GameState;
+        RemainingSecondsHandle = GameState->OnRemainingSecondsChanged.AddUObject(this, &ThisClass::RemainingSecondsChanged);
+        SetValue(ERogueHUDValue::RemainingSeconds, GameState->GetRemainingSeconds());
+    }
+}
+
+void URogueHUDModel::Deinitialize()
+{
+    UnbindCharacter();
+
+    if (APlayerController* PlayerController = OwningPlayerController.Get())
+    {
+        PlayerController->GetOnNewPawnNotifier().Remove(NewPawnHandle);
+    }
+
+    if (ARogueGameState* GameState = RogueGameState.Get())
+    {
+        GameState->OnRemainingSecondsChanged.Remove(RemainingSecondsHandle);
+    }
+
+    OwningPlayerController.Reset();
+    RogueGameState.Reset();
+}
+
+int32 URogueHUDModel::GetValue(ERogueHUDValue Value) const
+{
+    switch (Value)
+    {
+    case ERogueHUDValue::HitPoints:
+        return HitPoints;
+    case ERogueHUDValue::RemainingSeconds:
+        return RemainingSeconds;
+    default:
+        return 0;
+    }
+}
+
+void URogueHUDModel::PawnChanged(APawn* NewPawn)
+{
+    UnbindCharacter();
+
+    ARogueCharacterBase* NewCharacter = Cast<ARogueCharacterBase>(NewPawn);
+    if (!NewCharacter)
+    {
+        return;
+    }
+
+    Character = NewCharacter;
+    NewCharacter->OnCharacterHit.AddDynamic(this, &ThisClass::CharacterHitPointsChanged);
+    NewCharacter->OnCharacterDeath.AddDynamic(this, &ThisClass::CharacterHitPointsChanged);
+
+    if (ARoguePlayerCharacter* PlayerCharacter = Cast<ARoguePlayerCharacter>(NewCharacter))
+    {
+        PlayerCharacter->OnHitpointsAdded.AddDynamic(this, &ThisClass::CharacterHitPointsChanged);
+    }
+
+    CharacterHitPointsChanged();
+}
+
+void URogueHUDModel::CharacterHitPointsChanged()
+{
+    if (const ARogueCharacterBase* CurrentCharacter = Character.Get())
+    {
+        SetValue(ERogueHUDValue::HitPoints, CurrentCharacter->GetCurrentHitPoints());
+    }
+}
+
+void URogueHUDModel::RemainingSecondsChanged(int32 NewRemainingSeconds)
+{
+    SetValue(ERogueHUDValue::RemainingSeconds, NewRemainingSeconds);
+}
+
+void URogueHUDModel::SetValue(ERogueHUDValue Value, int32 NewValue)
+{
+    int32& CurrentValue = Value == ERogueHUDValue::HitPoints ? HitPoints : RemainingSeconds;
+    if (CurrentValue == NewValue)
+    {
+        return;
+    }
+
+    CurrentValue = NewValue;
+    INC_DWORD_STAT(STAT_RogueUIHUDValueChanges);
+
+    OnValueChanged.Broadcast(Value, NewValue);
+    OnValueChangedBP.Broadcast(Value, NewValue);
+}
+
+void URogueHUDModel::UnbindCharacter()
+{
+    if (ARogueCharacterBase* CurrentCharacter = Character.Get())
+    {
+        CurrentCharacter->OnCharacterHit.RemoveAll(this);
+        CurrentCharacter->OnCharacterDeath.RemoveAll(this);
+
+        if (ARoguePlayerCharacter* PlayerCharacter = Cast<ARoguePlayerCharacter>(CurrentCharacter))
+        {
+            PlayerCharacter->OnHitpointsAdded.RemoveAll(this);
+        }
+    }
+
+    Character.Reset();
+}
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UI/RogueHUDValueWidget.h"
+
+#include "CommonTextBlock.h"
+#include "Components/InvalidationBox.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "UI/RogueHUD.h"
+#include "UI/RogueHUDModel.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueHUDValueWidget)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Text Updates"), STAT_RogueUIHUDTextUpdates, STATGROUP_RogueUI);
+
+namespace RogueHUDValueCVars
+{
+    static bool bHUDInvalidation = true;
+    static FAutoConsoleVariableRef CVarHUDInvalidation(
+        TEXT("Rogue.UI.HUDInvalidation"),
+        bHUDInvalidation,
+        TEXT("When true, HUD value widgets cache their layout and paint in their invalidation box between value changes."),
+        FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+        {
+            for (TObjectIterator<URogueHUDValueWidget> It; It; ++It)
+            {
+                It->SetCachingEnabled(bHUDInvalidation);
+            }
+        }));
+}
+
+void URogueHUDValueWidget::SetCachingEnabled(bool bEnabled)
+{
+    if (InvalidationBox)
+    {
+        InvalidationBox->SetCanCache(bEnabled);
+    }
+}
+
+void URogueHUDValueWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+
+    SetCachingEnabled(RogueHUDValueCVars::bHUDInvalidation);
+
+    const APlayerController* PlayerController = GetOwningPlayer();
+    const ARogueHUD* RogueHUD                 = PlayerController ? PlayerController->GetHUD<ARogueHUD>() : nullptr;
+    URogueHUDModel* Model                     = RogueHUD ? RogueHUD->GetHUDModel() : nullptr;
+    if (!Model)
+    {
+        return;
+    }
+
+    HUDModel           = Model;
+    ValueChangedHandle = Model->OnValueChanged.AddUObject(this, &ThisClass::ValueChanged);
+    ValueChanged(Value, Model->GetValue(Value));
+}
+
+void URogueHUDValueWidget::NativeDestruct()
+{
+    if (URogueHUDModel* Model = HUDModel.Get())
+    {
+        Model->OnValueChanged.Remove(ValueChangedHandle);
+    }
+
+    HUDModel.Reset();
+
+    Super::NativeDestruct();
+}
+
+void URogueHUDValueWidget::ValueChanged(ERogueHUDValue ChangedValue, int32 NewValue)
+{
+    if (ChangedValue != Value || !ValueText)
+    {
+        return;
+    }
+
+    INC_DWORD_STAT(STAT_RogueUIHUDTextUpdates);
+
+    ValueText->SetText(FormatValue(NewValue));
+    OnValueChanged_BP(NewValue);
+}
+
+FText URogueHUDValueWidget::FormatValue(int32 NewValue) const
+{
+    if (Value == ERogueHUDValue::RemainingSeconds)
+    {
+        const FTimespan Remaining = FTimespan::FromSeconds(FMath::Max(NewValue, 0));
+        return FText::FromString(FString::Printf(TEXT("%d:%02d"), int32(Remaining.GetTotalMinutes()), Remaining.GetSeconds()));
+    }
+
+    return FText::AsNumber(NewValue);
+}
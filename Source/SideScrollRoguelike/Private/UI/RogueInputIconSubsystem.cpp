@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UI/RogueInputIconSubsystem.h"
+
+#include "CommonInputBaseTypes.h"
+#include "CommonInputSubsystem.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueInputIconSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueInputIcon);
+
+namespace RogueInputIconCVars
+{
+    static int32 PreloadBrushesPerFrame = 8;
+    static FAutoConsoleVariableRef CVarPreloadBrushesPerFrame(
+        TEXT("Rogue.InputIcons.PreloadPerFrame"),
+        PreloadBrushesPerFrame,
+        TEXT("Number of input brushes resolved per frame after the input method changes."));
+}
+
+void URogueInputIconSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // The input method events come from CommonInput, make sure it is around first
+    Collection.InitializeDependency<UCommonInputSubsystem>();
+
+    if (UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(GetLocalPlayer()))
+    {
+        CommonInputSubsystem->OnInputMethodChangedNative.AddUObject(this, &ThisClass::InputMethodChanged);
+    }
+}
+
+void URogueInputIconSubsystem::Deinitialize()
+{
+    if (UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(GetLocalPlayer()))
+    {
+        CommonInputSubsystem->OnInputMethodChangedNative.RemoveAll(this);
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(PreloadTickerHandle);
+    PreloadTickerHandle.Reset();
+
+    PreloadQueue.Empty();
+    Brushes.Empty();
+
+    Super::Deinitialize();
+}
+
+const FSlateBrush& URogueInputIconSubsystem::GetInputBrush(const FKey& Key, ECommonInputType InputType, FName GamepadName)
+{
+    if (!Key.IsValid())
+    {
+        return *FStyleDefaults::GetNoBrush();
+    }
+
+    if (const FSlateBrush* Brush = Brushes.Find({Key, InputType, GamepadName}))
+    {
+        return *Brush;
+    }
+
+    ++NumMisses;
+    UE_LOG(LogRogueInputIcon, Verbose, TEXT("URogueInputIconSubsystem::GetInputBrush %s was not preloaded (%d misses)."), *Key.ToString(), NumMisses);
+
+    return ResolveBrush(Key, InputType, GamepadName);
+}
+
+FSlateBrush URogueInputIconSubsystem::GetCurrentInputBrush(FKey Key)
+{
+    if (const UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(GetLocalPlayer()))
+    {
+        return GetInputBrush(Key, CommonInputSubsystem->GetCurrentInputType(), CommonInputSubsystem->GetCurrentGamepadName());
+    }
+
+    return *FStyleDefaults::GetNoBrush();
+}
+
+void URogueInputIconSubsystem::InputMethodChanged(ECommonInputType NewInputType)
+{
+    if (const UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(GetLocalPlayer()))
+    {
+        QueuePreload(NewInputType, CommonInputSubsystem->GetCurrentGamepadName());
+    }
+}
+
+void URogueInputIconSubsystem::QueuePreload(ECommonInputType InputType, FName GamepadName)
+{
+    const UEnhancedInputLocalPlayerSubsystem* EnhancedInputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer());
+    const UEnhancedInputUserSettings* Settings = EnhancedInputSubsystem ? EnhancedInputSubsystem->GetUserSettings() : nullptr;
+    const UEnhancedPlayerMappableKeyProfile* Profile = Settings ? Settings->GetActiveKeyProfile() : nullptr;
+    if (!Profile)
+    {
+        return;
+    }
+
+    // Only the keys that can show up for the new input type, switching back and forth keeps what was resolved before
+    PreloadQueue.Reset();
+    for (const TPair<FName, FKeyMappingRow>& Row : Profile->GetPlayerMappingRows())
+    {
+        for (const FPlayerKeyMapping& Mapping : Row.Value.Mappings)
+        {
+            const FKey& Key = Mapping.GetCurrentKey();
+            if (!Key.IsValid())
+            {
+                continue;
+            }
+
+            const bool bMatchesInputType = InputType == ECommonInputType::Gamepad ? Key.IsGamepadKey()
+                : InputType == ECommonInputType::Touch ? Key.IsTouch()
+                : !Key.IsGamepadKey() && !Key.IsTouch();
+
+            const FBrushKey BrushKey = {Key, InputType, GamepadName};
+            if (bMatchesInputType && !Brushes.Contains(BrushKey))
+            {
+                PreloadQueue.AddUnique(BrushKey);
+            }
+        }
+    }
+
+    if (PreloadQueue.Num() > 0 && !PreloadTickerHandle.IsValid())
+    {
+        PreloadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::PreloadQueuedBrushes));
+    }
+}
+
+bool URogueInputIconSubsystem::PreloadQueuedBrushes(float DeltaTime)
+{
+    const int32 NumToResolve = FMath::Min(PreloadQueue.Num(), FMath::Max(RogueInputIconCVars::PreloadBrushesPerFrame, 1));
+    for (int32 Index = 0; Index < NumToResolve; ++Index)
+    {
+        const FBrushKey BrushKey = PreloadQueue.Pop(EAllowShrinking::No);
+        if (!Brushes.Contains(BrushKey))
+        {
+            ResolveBrush(BrushKey.Key, BrushKey.InputType, BrushKey.GamepadName);
+        }
+    }
+
+    if (PreloadQueue.Num() > 0)
+    {
+        return true;
+    }
+
+    PreloadTickerHandle.Reset();
+    return false;
+}
+
+const FSlateBrush& URogueInputIconSubsystem::ResolveBrush(const FKey& Key, ECommonInputType InputType, FName GamepadName)
+{
+    FSlateBrush Brush = *FStyleDefaults::GetNoBrush();
+    UCommonInputPlatformSettings::Get()->TryGetInputBrush(Brush, Key, InputType, GamepadName);
+
+    return Brushes.Add({Key, InputType, GamepadName}, MoveTemp(Brush));
+}
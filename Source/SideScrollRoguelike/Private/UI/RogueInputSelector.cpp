@@ -5,6 +5,11 @@
 #include "UI/UserInterfaceBlueprintLibrary.h"
 #include "EnhancedInputSubsystems.h"
 #include "CommonInputSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Settings/RogueSettingsPersistenceSubsystem.h"
+#include "UI/RogueInputIconSubsystem.h"
+#include "UI/RogueKeyMappingIndexSubsystem.h"
+#include "UI/RogueRebindTransaction.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(RogueInputSelector)
 
@@ -57,22 +62,13 @@ FText URogueInputSelector::GetKeyTextFromSlot(const EPlayerMappableKeySlot InSlo
         return InProgressSelectionText;
     }
 
-    if (const UEnhancedPlayerMappableKeyProfile* Profile = FindMappableKeyProfile())
+    if (const FRogueKeyMappingView* View = FindIndexedMappings())
     {
-        FPlayerMappableKeyQueryOptions QueryOptionsForSlot = QueryOptions;
-        QueryOptionsForSlot.SlotToMatch                    = InSlot;
-
-        if (const FKeyMappingRow* Row = FindKeyMappingRow())
+        if (const FRogueIndexedKeyMapping* Mapping = View->FindSlot(InSlot))
         {
-            for (const FPlayerKeyMapping& Mapping : Row->Mappings)
-            {
-                if (Profile->DoesMappingPassQueryOptions(Mapping, QueryOptionsForSlot))
-                {
-                    // We've passed the query check and GetCurrentKey will always return a valid key
-                    // So we can just return the display name of the key here
-                    return Mapping.GetCurrentKey().GetDisplayName();
-                }
-            }
+            // We've passed the query check and the current key will always be valid
+            // So we can just return the display name of the key here
+            return Mapping->CurrentKey.GetDisplayName();
         }
     }
 
@@ -82,23 +78,22 @@ FText URogueInputSelector::GetKeyTextFromSlot(const EPlayerMappableKeySlot InSlo
 FSlateBrush URogueInputSelector::GetKeyIconFromSlot(const UCommonInputSubsystem* CommonInputSubsystem, const EPlayerMappableKeySlot InSlot, ECommonInputType InputType)
 {
     FKey TargetKey = FKey();
-    if (const UEnhancedPlayerMappableKeyProfile* Profile = FindMappableKeyProfile())
+    if (const FRogueKeyMappingView* View = FindIndexedMappings())
     {
-        FPlayerMappableKeyQueryOptions QueryOptionsForSlot = QueryOptions;
-        QueryOptionsForSlot.SlotToMatch                    = InSlot;
-
-        if (const FKeyMappingRow* Row = FindKeyMappingRow())
+        // The last mapping passing the query wins, as it did when the profile row was walked here
+        if (const FRogueIndexedKeyMapping* Mapping = View->FindLastSlot(InSlot))
         {
-            for (const FPlayerKeyMapping& Mapping : Row->Mappings)
-            {
-                if (Profile->DoesMappingPassQueryOptions(Mapping, QueryOptionsForSlot))
-                {
-                    TargetKey = Mapping.GetCurrentKey();
-                }
-            }
+            TargetKey = Mapping->CurrentKey;
         }
     }
 
+    // Brushes are resolved once per key, input type and gamepad and then read from the local player's icon cache
+    const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+    if (URogueInputIconSubsystem* IconSubsystem = LocalPlayer ? LocalPlayer->GetSubsystem<URogueInputIconSubsystem>() : nullptr)
+    {
+        return IconSubsystem->GetInputBrush(TargetKey, InputType, CommonInputSubsystem->GetCurrentGamepadName());
+    }
+
     FSlateBrush SlateBrush;
     if (TargetKey.IsValid() && UCommonInputPlatformSettings::Get()->TryGetInputBrush(SlateBrush, TargetKey, InputType, CommonInputSubsystem->GetCurrentGamepadName()))
     {
@@ -111,17 +106,13 @@ FSlateBrush URogueInputSelector::GetKeyIconFromSlot(const UCommonInputSubsystem*
 void URogueInputSelector::StoreInitial()
 {
     InitialKeyMappings.Empty();
-    if (const UEnhancedPlayerMappableKeyProfile* Profile = FindMappableKeyProfile())
+    if (const FRogueKeyMappingView* View = FindIndexedMappings())
     {
-        if (const FKeyMappingRow* Row = FindKeyMappingRow())
+        for (const FRogueIndexedKeyMapping& Mapping : View->Mappings)
         {
-            for (const FPlayerKeyMapping& Mapping : Row->Mappings)
+            if (DoesSlotPassQueryOptions(Mapping.Slot))
             {
-                if (Profile->DoesMappingPassQueryOptions(Mapping, QueryOptions))
-                {
-                    ActionMappingName = Mapping.GetMappingName();
-                    InitialKeyMappings.Add(Mapping.GetSlot(), Mapping.GetCurrentKey());
-                }
+                InitialKeyMappings.Add(Mapping.Slot, Mapping.CurrentKey);
             }
         }
     }
@@ -143,128 +134,72 @@ void URogueInputSelector::ResetToDefault(const EPlayerMappableKeySlot InSlot)
         {
             UE_LOG(LogRogueInputSelector, Error, TEXT("URogueInputSelector::ResetToDefault: Failed to reset player keys in row to default."));
         }
+
+        InvalidateMappingIndex();
+        RequestSaveSettings(Settings);
     }
 }
 
 void URogueInputSelector::RestoreToInitial()
 {
     bIsSelectingKey = false;
-    for (TPair<EPlayerMappableKeySlot, FKey> Pair : InitialKeyMappings)
+
+    // All slots go back in one transaction instead of one rebind per slot
+    if (URogueRebindTransaction* Transaction = URogueRebindTransaction::BeginRebind(GetOwningLocalPlayer()))
     {
-        ChangeBinding((int32)Pair.Key, Pair.Value, false);
+        for (const TPair<EPlayerMappableKeySlot, FKey>& Pair : InitialKeyMappings)
+        {
+            Transaction->QueueMap(ActionMappingName, Pair.Key, Pair.Value, false);
+        }
+
+        Transaction->Commit(true);
+        InvalidateMappingIndex();
     }
 }
 
 bool URogueInputSelector::ChangeBinding(int32 InKeyBindSlot, FKey NewKey, bool bUpdateOverlappingKeys)
+{
+    return ChangeBindings({InKeyBindSlot}, NewKey, bUpdateOverlappingKeys);
+}
+
+bool URogueInputSelector::ChangeBindings(const TArray<int32>& InKeyBindSlots, FKey NewKey, bool bUpdateOverlappingKeys)
 {
     bool bCanAssign = false;
 
     const UEnhancedPlayerMappableKeyProfile* Profile = FindMappableKeyProfile();
 
     // Check our query against profile to see if we can assign to this binding
-    if (IsValid(Profile))
+    if (IsValid(Profile) && InKeyBindSlots.Num() > 0)
     {
-        if (const FKeyMappingRow* Row = FindKeyMappingRow())
+        if (const FRogueKeyMappingView* View = FindIndexedMappings())
         {
-            for (const FPlayerKeyMapping& Mapping : Row->Mappings)
+            bCanAssign = View->Mappings.ContainsByPredicate([this](const FRogueIndexedKeyMapping& Mapping)
             {
-                if (Profile->DoesMappingPassQueryOptions(Mapping, QueryOptions))
-                {
-                    bCanAssign = true;
-                    break;
-                }
-            }
+                return DoesSlotPassQueryOptions(Mapping.Slot);
+            });
         }
     }
 
-    bool bUpdatedAlreadyMappedKey = false;
-
     // Handle the assignment
     if (bCanAssign)
     {
-        // Setup our mappable key arguments for the action mapping
-        FMapPlayerKeyArgs Args = {};
-        Args.MappingName       = ActionMappingName;
-        Args.Slot              = (EPlayerMappableKeySlot)(static_cast<uint8>(InKeyBindSlot));
-
-        // If you want to, you can additionally specify this mapping to only be applied to a certain hardware device or key profile
-        // Args.ProfileId =
-        // Args.HardwareDeviceId =
-
-        if (UEnhancedInputUserSettings* Settings = GetUserSettings())
+        // Every slot, with its unmap, map and optional key swap, is applied as one transaction with a single mapping context rebuild and save
+        if (URogueRebindTransaction* Transaction = URogueRebindTransaction::BeginRebind(GetOwningLocalPlayer()))
         {
-            if (bUpdateOverlappingKeys)
+            for (const int32 KeyBindSlot : InKeyBindSlots)
             {
-                // Check if any other mapping is already using the key we're about to assign
-                // Swap it with whatever is already assigned to this action
-                TArray<FName> MatchedMappingNames;
-                int32 MatchCount = Profile->GetMappingNamesForKey(NewKey, MatchedMappingNames);
-
-                if (MatchCount > 0)
-                {
-                    FName FoundMapping = MatchedMappingNames[0];
-
-                    FMapPlayerKeyArgs BindArgs = {};
-                    BindArgs.MappingName       = FoundMapping;
-                    BindArgs.Slot              = Args.Slot;
-
-                    // Unmap the old key
-                    FGameplayTagContainer FailureReason;
-                    Settings->UnMapPlayerKey(BindArgs, FailureReason);
-
-                    if (!FailureReason.IsEmpty())
-                    {
-                        UE_LOG(LogRogueInputSelector, Error, TEXT("URogueInputSelector::ChangeBinding: Failed to unmap player key."));
-                    }
-
-                    // Get the current row we're operating on
-                    const FKeyMappingRow* MappingRow = FindKeyMappingRow();
-                    FKey ExistingKey;
-                    for (const FPlayerKeyMapping& Mapping : MappingRow->Mappings)
-                    {
-                        if (Mapping.GetSlot() == Args.Slot)
-                        {
-                            ExistingKey = Mapping.GetCurrentKey();
-                            break;
-                        }
-                    }
-
-                    // Map the new key
-                    BindArgs.NewKey = ExistingKey;
-                    FailureReason.Reset();
-
-                    Settings->MapPlayerKey(BindArgs, FailureReason);
-
-                    if (!FailureReason.IsEmpty())
-                    {
-                        UE_LOG(LogRogueInputSelector, Error, TEXT("URogueInputSelector::ChangeBinding: Failed to map player key."));
-                    }
-
-                    bUpdatedAlreadyMappedKey = true;
-                }
+                Transaction->QueueMap(ActionMappingName, (EPlayerMappableKeySlot)(static_cast<uint8>(KeyBindSlot)), NewKey, bUpdateOverlappingKeys);
             }
 
-            // Unmap the old key
-            FGameplayTagContainer FailureReason;
-            Settings->UnMapPlayerKey(Args, FailureReason);
-
-            if (!FailureReason.IsEmpty())
+            if (!Transaction->Commit(true))
             {
-                UE_LOG(LogRogueInputSelector, Error, TEXT("URogueInputSelector::ChangeBinding: Failed to unmap player key."));
+                UE_LOG(LogRogueInputSelector, Error, TEXT("URogueInputSelector::ChangeBindings: Failed to map player key."));
+                return false;
             }
 
-            FailureReason.Reset();
-
-            // Map the new key
-            Args.NewKey = NewKey;
-            Settings->MapPlayerKey(Args, FailureReason);
-
-            if (!FailureReason.IsEmpty())
-            {
-                UE_LOG(LogRogueInputSelector, Error, TEXT("URogueInputSelector::ChangeBinding: Failed to map player key."));
-            }
+            InvalidateMappingIndex();
 
-            if (bUpdatedAlreadyMappedKey)
+            if (Transaction->GetNumSwaps() > 0)
             {
                 // Changing the binding caused a key swap. Broadcast our event to update all impacted selectors.
                 OnKeySwapped.Broadcast();
@@ -281,18 +216,13 @@ bool URogueInputSelector::IsMappingCustomized() const
 {
     bool bResult = false;
 
-    if (const UEnhancedPlayerMappableKeyProfile* Profile = FindMappableKeyProfile())
+    if (const FRogueKeyMappingView* View = FindIndexedMappings())
     {
-        FPlayerMappableKeyQueryOptions QueryOptionsForSlot = QueryOptions;
-
-        if (const FKeyMappingRow* Row = FindKeyMappingRow())
+        for (const FRogueIndexedKeyMapping& Mapping : View->Mappings)
         {
-            for (const FPlayerKeyMapping& Mapping : Row->Mappings)
+            if (DoesSlotPassQueryOptions(Mapping.Slot))
             {
-                if (Profile->DoesMappingPassQueryOptions(Mapping, QueryOptionsForSlot))
-                {
-                    bResult |= Mapping.IsCustomized();
-                }
+                bResult |= Mapping.bCustomized;
             }
         }
     }
@@ -337,6 +267,24 @@ const FKeyMappingRow* URogueInputSelector::FindKeyMappingRow() const
     return nullptr;
 }
 
+const FRogueKeyMappingView* URogueInputSelector::FindIndexedMappings() const
+{
+    if (const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer())
+    {
+        if (URogueKeyMappingIndexSubsystem* Index = LocalPlayer->GetSubsystem<URogueKeyMappingIndexSubsystem>())
+        {
+            return Index->FindMappings(ProfileIdentifier, ActionMappingName, QueryOptions);
+        }
+    }
+
+    return nullptr;
+}
+
+bool URogueInputSelector::DoesSlotPassQueryOptions(EPlayerMappableKeySlot Slot) const
+{
+    return QueryOptions.SlotToMatch == EPlayerMappableKeySlot::Unspecified || QueryOptions.SlotToMatch == Slot;
+}
+
 bool URogueInputSelector::DoKeyTypesMatch(const FKey& A, const FKey& B)
 {
     return A.IsGamepadKey() == B.IsGamepadKey() &&
@@ -415,20 +363,15 @@ FReply URogueInputSelector::NativeOnMouseButtonUp(const FGeometry& InGeometry, c
         return FReply::Handled();
     }
 
-    bool bHasChanged = false;
-
-    // Stack up the keys to change for a slot
-    // The Initial Key Mappings can change as a result of rebinding so we can't just loop them here
+    // Collect the slots to change first, the Initial Key Mappings can change as a result of rebinding
     TArray<int32> Slots;
     for (TPair<EPlayerMappableKeySlot, FKey> Pair : InitialKeyMappings)
     {
         Slots.Add((int32)Pair.Key);
     }
 
-    while (Slots.Num() > 0)
-    {
-        bHasChanged |= ChangeBinding(Slots.Pop(), SelectedKey);
-    }
+    // All slots are rebound in one transaction
+    const bool bHasChanged = ChangeBindings(Slots, SelectedKey);
 
     if (bHasChanged)
     {
@@ -457,20 +400,15 @@ FReply URogueInputSelector::NativeOnKeyUp(const FGeometry& InGeometry, const FKe
         return FReply::Handled();
     }
 
-    bool bHasChanged = false;
-
-    // Stack up the keys to change for a slot
-    // The Initial Key Mappings can change as a result of rebinding so we can't just loop them here
+    // Collect the slots to change first, the Initial Key Mappings can change as a result of rebinding
     TArray<int32> Slots;
     for (TPair<EPlayerMappableKeySlot, FKey> Pair : InitialKeyMappings)
     {
         Slots.Add((int32)Pair.Key);
     }
 
-    while (Slots.Num() > 0)
-    {
-        bHasChanged |= ChangeBinding(Slots.Pop(), SelectedKey);
-    }
+    // All slots are rebound in one transaction
+    const bool bHasChanged = ChangeBindings(Slots, SelectedKey);
 
     if (bHasChanged)
     {
@@ -550,14 +488,16 @@ FReply URogueInputSelector::NativeOnAnalogValueChanged(const FGeometry& InGeomet
         return FReply::Handled();
     }
 
-    bool bHasChanged = false;
-
-    // Change the key for the target slot
+    // Collect the slots to change first, the Initial Key Mappings can change as a result of rebinding
+    TArray<int32> Slots;
     for (TPair<EPlayerMappableKeySlot, FKey> Pair : InitialKeyMappings)
     {
-        bHasChanged |= ChangeBinding((int32)Pair.Key, SelectedKey);
+        Slots.Add((int32)Pair.Key);
     }
 
+    // All slots are rebound in one transaction
+    const bool bHasChanged = ChangeBindings(Slots, SelectedKey);
+
     if (bHasChanged)
     {
         bIsSelectingKey = false;
@@ -595,6 +535,32 @@ UEnhancedInputUserSettings* URogueInputSelector::GetUserSettings() const
     return nullptr;
 }
 
+void URogueInputSelector::InvalidateMappingIndex() const
+{
+    // Enhanced Input reports changes to the index too, but other selectors refresh right after this and must not read stale keys
+    const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+    if (URogueKeyMappingIndexSubsystem* Index = LocalPlayer ? LocalPlayer->GetSubsystem<URogueKeyMappingIndexSubsystem>() : nullptr)
+    {
+        Index->Invalidate();
+    }
+}
+
+void URogueInputSelector::RequestSaveSettings(UEnhancedInputUserSettings* Settings) const
+{
+    const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+    const UGameInstance* GameInstance = LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr;
+
+    // Rebinding several keys in a row results in a single save
+    if (URogueSettingsPersistenceSubsystem* Persistence = GameInstance ? GameInstance->GetSubsystem<URogueSettingsPersistenceSubsystem>() : nullptr)
+    {
+        Persistence->RequestSaveInputSettings(Settings);
+    }
+    else if (Settings)
+    {
+        Settings->AsyncSaveSettings();
+    }
+}
+
 FEventReply URogueInputSelector::OnParentMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
     FEventReply Reply;
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UI/RogueKeyMappingIndexSubsystem.h"
+
+#include "EnhancedInputSubsystems.h"
+#include "Engine/LocalPlayer.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueKeyMappingIndexSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueKeyMappingIndex);
+
+void URogueKeyMappingIndexSubsystem::Deinitialize()
+{
+    BindToUserSettings(nullptr);
+    Views.Empty();
+
+    Super::Deinitialize();
+}
+
+const FRogueKeyMappingView* URogueKeyMappingIndexSubsystem::FindMappings(const FString& ProfileId, FName MappingName, const FPlayerMappableKeyQueryOptions& QueryOptions)
+{
+    UEnhancedInputUserSettings* Settings = GetUserSettings();
+    if (!Settings)
+    {
+        return nullptr;
+    }
+
+    // The settings object is created by Enhanced Input after this subsystem, bind once it exists
+    if (BoundUserSettings.Get() != Settings)
+    {
+        BindToUserSettings(Settings);
+    }
+
+    FQueryKey Key;
+    Key.ProfileId           = ProfileId;
+    Key.MappingName         = MappingName;
+    Key.KeyToMatch          = QueryOptions.KeyToMatch.GetFName();
+    Key.RequiredDeviceType  = QueryOptions.RequiredDeviceType;
+    Key.RequiredDeviceFlags = QueryOptions.RequiredDeviceFlags;
+    Key.bMatchBasicKeyTypes = QueryOptions.bMatchBasicKeyTypes;
+    Key.bMatchKeyAxisType   = QueryOptions.bMatchKeyAxisType;
+
+    if (const FRogueKeyMappingView* View = Views.Find(Key))
+    {
+        ++NumHits;
+        return View;
+    }
+
+    const UEnhancedPlayerMappableKeyProfile* Profile = Settings->GetKeyProfileWithId(ProfileId);
+    if (!Profile)
+    {
+        return nullptr;
+    }
+
+    // Run the profile's own query once per mapping, the slot is matched by the view afterwards
+    FPlayerMappableKeyQueryOptions AnySlotOptions = QueryOptions;
+    AnySlotOptions.SlotToMatch                    = EPlayerMappableKeySlot::Unspecified;
+
+    FRogueKeyMappingView& View = Views.Add(Key);
+    if (const FKeyMappingRow* Row = Profile->FindKeyMappingRow(MappingName))
+    {
+        View.bHasRow = true;
+
+        for (const FPlayerKeyMapping& Mapping : Row->Mappings)
+        {
+            if (Profile->DoesMappingPassQueryOptions(Mapping, AnySlotOptions))
+            {
+                FRogueIndexedKeyMapping& Indexed = View.Mappings.AddDefaulted_GetRef();
+                Indexed.Slot                     = Mapping.GetSlot();
+                Indexed.CurrentKey               = Mapping.GetCurrentKey();
+                Indexed.bCustomized              = Mapping.IsCustomized();
+            }
+        }
+    }
+
+    ++NumBuilds;
+    return &View;
+}
+
+void URogueKeyMappingIndexSubsystem::Invalidate()
+{
+    if (Views.Num() > 0)
+    {
+        UE_LOG(LogRogueKeyMappingIndex, Verbose, TEXT("URogueKeyMappingIndexSubsystem::Invalidate dropping %d views (%d built, %d reused)."), Views.Num(), NumBuilds, NumHits);
+    }
+
+    Views.Reset();
+    NumBuilds = 0;
+    NumHits   = 0;
+}
+
+UEnhancedInputUserSettings* URogueKeyMappingIndexSubsystem::GetUserSettings() const
+{
+    if (const UEnhancedInputLocalPlayerSubsystem* System = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer()))
+    {
+        return System->GetUserSettings();
+    }
+
+    return nullptr;
+}
+
+void URogueKeyMappingIndexSubsystem::BindToUserSettings(UEnhancedInputUserSettings* Settings)
+{
+    if (UEnhancedInputUserSettings* PreviousSettings = BoundUserSettings.Get())
+    {
+        PreviousSettings->OnSettingsChanged.RemoveDynamic(this, &ThisClass::UserSettingsChanged);
+        PreviousSettings->OnKeyProfileChanged.RemoveDynamic(this, &ThisClass::KeyProfileChanged);
+    }
+
+    BoundUserSettings = Settings;
+    Invalidate();
+
+    if (Settings)
+    {
+        Settings->OnSettingsChanged.AddDynamic(this, &ThisClass::UserSettingsChanged);
+        Settings->OnKeyProfileChanged.AddDynamic(this, &ThisClass::KeyProfileChanged);
+    }
+}
+
+void URogueKeyMappingIndexSubsystem::UserSettingsChanged(UEnhancedInputUserSettings* Settings)
+{
+    Invalidate();
+}
+
+void URogueKeyMappingIndexSubsystem::KeyProfileChanged(const UEnhancedPlayerMappableKeyProfile* NewProfile)
+{
+    Invalidate();
+}
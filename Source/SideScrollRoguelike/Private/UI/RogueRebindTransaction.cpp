@@ -0,0 +1,397 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UI/RogueRebindTransaction.h"
+
+#include "EnhancedInputSubsystems.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+#include "Settings/RogueSettingsPersistenceSubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueRebindTransaction)
+
+DEFINE_LOG_CATEGORY(LogRogueRebindTransaction);
+
+namespace RogueRebindCommands
+{
+    static FAutoConsoleCommandWithWorldAndArgs RebindBenchmark(
+        TEXT("Rogue.Input.RebindBenchmark"),
+        TEXT("Resets customized actions to default per action and as one rebind transaction, and logs the cost and mapping context rebuilds of both. Usage: Rogue.Input.RebindBenchmark [NumActions=50]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (GEngine && World)
+            {
+                URogueRebindTransaction::RunResetBenchmark(GEngine->GetFirstGamePlayer(World), Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50);
+            }
+        }));
+}
+
+URogueRebindTransaction* URogueRebindTransaction::BeginRebind(ULocalPlayer* LocalPlayer)
+{
+    const UEnhancedInputLocalPlayerSubsystem* System = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer);
+    UEnhancedInputUserSettings* UserSettings         = System ? System->GetUserSettings() : nullptr;
+    if (!UserSettings || !UserSettings->GetActiveKeyProfile())
+    {
+        UE_LOG(LogRogueRebindTransaction, Error, TEXT("URogueRebindTransaction::BeginRebind unable to get the key profile from the local player's Enhanced Input user settings."));
+        return nullptr;
+    }
+
+    URogueRebindTransaction* Transaction = NewObject<URogueRebindTransaction>(LocalPlayer);
+    Transaction->OwningLocalPlayer        = LocalPlayer;
+    Transaction->Settings                 = UserSettings;
+    Transaction->Profile                  = UserSettings->GetActiveKeyProfile();
+    return Transaction;
+}
+
+void URogueRebindTransaction::QueueMap(FName MappingName, EPlayerMappableKeySlot Slot, FKey NewKey, bool bSwapOverlapping)
+{
+    FOperation& Operation      = Operations.AddDefaulted_GetRef();
+    Operation.Type             = FOperation::EType::Map;
+    Operation.Target           = {MappingName, Slot};
+    Operation.NewKey           = NewKey;
+    Operation.bSwapOverlapping = bSwapOverlapping;
+}
+
+void URogueRebindTransaction::QueueUnmap(FName MappingName, EPlayerMappableKeySlot Slot)
+{
+    FOperation& Operation = Operations.AddDefaulted_GetRef();
+    Operation.Type        = FOperation::EType::Unmap;
+    Operation.Target      = {MappingName, Slot};
+}
+
+void URogueRebindTransaction::QueueResetToDefault(FName MappingName, EPlayerMappableKeySlot Slot)
+{
+    FOperation& Operation = Operations.AddDefaulted_GetRef();
+    Operation.Type        = FOperation::EType::Reset;
+    Operation.Target      = {MappingName, Slot};
+}
+
+TArray<FRogueRebindConflict> URogueRebindTransaction::Validate()
+{
+    PlanChanges();
+
+    // One pass over the planned bindings to find the actions holding each key
+    TMap<FKey, TArray<FName, TInlineAllocator<2>>> KeyOwners;
+    for (const TPair<FSlotKey, FKey>& Planned : PlannedKeys)
+    {
+        if (Planned.Value.IsValid())
+        {
+            KeyOwners.FindOrAdd(Planned.Value).AddUnique(Planned.Key.MappingName);
+        }
+    }
+
+    // Only keys touched by this transaction are reported, conflicts that were already there are not its business
+    TArray<FRogueRebindConflict> Conflicts;
+    for (const TPair<FSlotKey, FKey>& Planned : PlannedKeys)
+    {
+        if (!Planned.Value.IsValid() || Planned.Value == CurrentKeys.FindRef(Planned.Key))
+        {
+            continue;
+        }
+
+        const TArray<FName, TInlineAllocator<2>>& Owners = KeyOwners.FindChecked(Planned.Value);
+        if (Owners.Num() > 1 && !Conflicts.ContainsByPredicate([&Planned](const FRogueRebindConflict& Conflict) { return Conflict.Key == Planned.Value; }))
+        {
+            FRogueRebindConflict& Conflict = Conflicts.AddDefaulted_GetRef();
+            Conflict.Key                   = Planned.Value;
+            Conflict.MappingNames          = Owners;
+        }
+    }
+
+    return Conflicts;
+}
+
+bool URogueRebindTransaction::Commit(bool bAllowConflicts)
+{
+    const TArray<FRogueRebindConflict> Conflicts = Validate();
+    if (Conflicts.Num() > 0 && !bAllowConflicts)
+    {
+        UE_LOG(LogRogueRebindTransaction, Warning, TEXT("URogueRebindTransaction::Commit refused, %d keys would be mapped to more than one action."), Conflicts.Num());
+        return false;
+    }
+
+    UEnhancedInputUserSettings* UserSettings      = Settings.Get();
+    UEnhancedPlayerMappableKeyProfile* KeyProfile = Profile.Get();
+    if (!UserSettings || !KeyProfile)
+    {
+        UE_LOG(LogRogueRebindTransaction, Error, TEXT("URogueRebindTransaction::Commit the key profile is gone."));
+        return false;
+    }
+
+    NumRebuildRequests = 0;
+
+    // The settings broadcast a change for every key they map. The listeners are set aside while the changes are applied
+    // and told once at the end, so the mapping contexts are rebuilt once per transaction.
+    decltype(UserSettings->OnSettingsChanged) SettingsChangedListeners = UserSettings->OnSettingsChanged;
+    UserSettings->OnSettingsChanged.Clear();
+
+    for (const TPair<FSlotKey, FKey>& Planned : PlannedKeys)
+    {
+        if (Planned.Value == CurrentKeys.FindRef(Planned.Key))
+        {
+            continue;
+        }
+
+        FMapPlayerKeyArgs Args = {};
+        Args.MappingName       = Planned.Key.MappingName;
+        Args.Slot              = Planned.Key.Slot;
+        Args.NewKey            = Planned.Value;
+        Args.ProfileId         = KeyProfile->GetProfileIdString();
+
+        // The settings keep their own bookkeeping of dirty mappings and slots, changes always go through them
+        FGameplayTagContainer FailureReason;
+        if (Planned.Value.IsValid())
+        {
+            UserSettings->MapPlayerKey(Args, FailureReason);
+        }
+        else
+        {
+            UserSettings->UnMapPlayerKey(Args, FailureReason);
+        }
+
+        if (!FailureReason.IsEmpty())
+        {
+            UE_LOG(LogRogueRebindTransaction, Error, TEXT("URogueRebindTransaction::Commit failed to map %s to %s: %s."),
+                *Planned.Value.ToString(), *Planned.Key.MappingName.ToString(), *FailureReason.ToStringSimple());
+        }
+    }
+
+    UserSettings->OnSettingsChanged = SettingsChangedListeners;
+
+    Operations.Reset();
+
+    if (NumChanges == 0)
+    {
+        return true;
+    }
+
+    // Tell Enhanced Input once, it rebuilds the mapping contexts and the key mapping index drops its views
+    UserSettings->OnSettingsChanged.Broadcast(UserSettings);
+    ++NumRebuildRequests;
+
+    if (bSaveOnCommit)
+    {
+        const ULocalPlayer* LocalPlayer   = OwningLocalPlayer.Get();
+        const UGameInstance* GameInstance = LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr;
+        if (URogueSettingsPersistenceSubsystem* Persistence = GameInstance ? GameInstance->GetSubsystem<URogueSettingsPersistenceSubsystem>() : nullptr)
+        {
+            Persistence->RequestSaveInputSettings(UserSettings);
+        }
+        else
+        {
+            UserSettings->AsyncSaveSettings();
+        }
+    }
+
+    return true;
+}
+
+void URogueRebindTransaction::CaptureProfile()
+{
+    CurrentKeys.Reset();
+    DefaultKeys.Reset();
+
+    const UEnhancedPlayerMappableKeyProfile* KeyProfile = Profile.Get();
+    if (!KeyProfile)
+    {
+        return;
+    }
+
+    for (const TPair<FName, FKeyMappingRow>& Row : KeyProfile->GetPlayerMappingRows())
+    {
+        for (const FPlayerKeyMapping& Mapping : Row.Value.Mappings)
+        {
+            const FSlotKey SlotKey = {Mapping.GetMappingName(), Mapping.GetSlot()};
+            CurrentKeys.Add(SlotKey, Mapping.GetCurrentKey());
+            DefaultKeys.Add(SlotKey, Mapping.GetDefaultKey());
+        }
+    }
+}
+
+void URogueRebindTransaction::PlanChanges()
+{
+    CaptureProfile();
+
+    PlannedKeys = CurrentKeys;
+    NumSwaps    = 0;
+
+    for (const FOperation& Operation : Operations)
+    {
+        switch (Operation.Type)
+        {
+            case FOperation::EType::Map:
+            {
+                if (Operation.bSwapOverlapping)
+                {
+                    // Same as a single rebind: the first action already using the key gets this slot's old key
+                    FName OverlappingMappingName = NAME_None;
+                    for (const TPair<FSlotKey, FKey>& Planned : PlannedKeys)
+                    {
+                        // Another slot of the same action holding the key is not an overlap, there is nothing to swap with
+                        if (Planned.Value == Operation.NewKey && Planned.Key.MappingName != Operation.Target.MappingName)
+                        {
+                            OverlappingMappingName = Planned.Key.MappingName;
+                            break;
+                        }
+                    }
+
+                    if (!OverlappingMappingName.IsNone())
+                    {
+                        PlannedKeys.Add({OverlappingMappingName, Operation.Target.Slot}, PlannedKeys.FindRef(Operation.Target));
+                        ++NumSwaps;
+                    }
+                }
+
+                PlannedKeys.Add(Operation.Target, Operation.NewKey);
+                break;
+            }
+
+            case FOperation::EType::Unmap:
+            {
+                PlannedKeys.Add(Operation.Target, EKeys::Invalid);
+                break;
+            }
+
+            case FOperation::EType::Reset:
+            {
+                for (const TPair<FSlotKey, FKey>& Default : DefaultKeys)
+                {
+                    if (Default.Key.MappingName == Operation.Target.MappingName && (Operation.Target.Slot == EPlayerMappableKeySlot::Unspecified || Default.Key.Slot == Operation.Target.Slot))
+                    {
+                        PlannedKeys.Add(Default.Key, Default.Value);
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    NumChanges = 0;
+    for (const TPair<FSlotKey, FKey>& Planned : PlannedKeys)
+    {
+        if (Planned.Value != CurrentKeys.FindRef(Planned.Key))
+        {
+            ++NumChanges;
+        }
+    }
+}
+
+void URogueRebindTransaction::CountSettingsChanged(UEnhancedInputUserSettings* ChangedSettings)
+{
+    ++NumSettingsChangedBroadcasts;
+}
+
+bool URogueRebindTransaction::RunResetBenchmark(ULocalPlayer* LocalPlayer, int32 NumActions, FResetBenchmarkResult* OutResult)
+{
+    URogueRebindTransaction* Probe = BeginRebind(LocalPlayer);
+    if (!Probe)
+    {
+        return false;
+    }
+
+    UEnhancedInputUserSettings* UserSettings = Probe->Settings.Get();
+    Probe->CaptureProfile();
+
+    // One slot with a default key per action
+    TArray<FSlotKey> Targets;
+    for (const TPair<FSlotKey, FKey>& Default : Probe->DefaultKeys)
+    {
+        if (Targets.Num() < NumActions && Default.Value.IsValid() && !Targets.ContainsByPredicate([&Default](const FSlotKey& Target) { return Target.MappingName == Default.Key.MappingName; }))
+        {
+            Targets.Add(Default.Key);
+        }
+    }
+
+    if (Targets.Num() < 2)
+    {
+        UE_LOG(LogRogueRebindTransaction, Warning, TEXT("URogueRebindTransaction::RunResetBenchmark needs at least two actions with default keys."));
+        return false;
+    }
+
+    const TMap<FSlotKey, FKey> OriginalKeys = Probe->CurrentKeys;
+
+    // Customizes every target by rotating the default keys between them, without saving
+    const auto Scramble = [LocalPlayer, &Targets, Probe]()
+    {
+        URogueRebindTransaction* Transaction = BeginRebind(LocalPlayer);
+        Transaction->bSaveOnCommit           = false;
+        for (int32 Index = 0; Index < Targets.Num(); ++Index)
+        {
+            const FSlotKey& Target = Targets[Index];
+            Transaction->QueueMap(Target.MappingName, Target.Slot, Probe->DefaultKeys.FindRef(Targets[(Index + 1) % Targets.Num()]), false);
+        }
+        Transaction->Commit(true);
+    };
+
+    UserSettings->OnSettingsChanged.AddDynamic(Probe, &ThisClass::CountSettingsChanged);
+
+    // The way the input selectors reset, one action at a time
+    Scramble();
+    Probe->NumSettingsChangedBroadcasts = 0;
+    const double PerActionStartTime     = FPlatformTime::Seconds();
+    for (const FSlotKey& Target : Targets)
+    {
+        FMapPlayerKeyArgs Args = {};
+        Args.MappingName       = Target.MappingName;
+        Args.Slot              = Target.Slot;
+
+        FGameplayTagContainer FailureReason;
+        UserSettings->ResetAllPlayerKeysInRow(Args, FailureReason);
+    }
+    const double PerActionMs      = (FPlatformTime::Seconds() - PerActionStartTime) * 1000.0;
+    const int32 PerActionRebuilds = Probe->NumSettingsChangedBroadcasts;
+
+    // All actions in one transaction
+    Scramble();
+    Probe->NumSettingsChangedBroadcasts  = 0;
+    const double TransactionStartTime    = FPlatformTime::Seconds();
+    URogueRebindTransaction* Transaction = BeginRebind(LocalPlayer);
+    Transaction->bSaveOnCommit           = false;
+    for (const FSlotKey& Target : Targets)
+    {
+        Transaction->QueueResetToDefault(Target.MappingName, Target.Slot);
+    }
+    Transaction->Commit(true);
+    const double TransactionMs      = (FPlatformTime::Seconds() - TransactionStartTime) * 1000.0;
+    const int32 TransactionRebuilds = Probe->NumSettingsChangedBroadcasts;
+
+    UserSettings->OnSettingsChanged.RemoveDynamic(Probe, &ThisClass::CountSettingsChanged);
+
+    // Put the bindings back the way the player had them, every slot of the targets since the per action reset clears the whole row
+    URogueRebindTransaction* Restore = BeginRebind(LocalPlayer);
+    Restore->bSaveOnCommit           = false;
+    for (const TPair<FSlotKey, FKey>& Original : OriginalKeys)
+    {
+        if (!Targets.ContainsByPredicate([&Original](const FSlotKey& Target) { return Target.MappingName == Original.Key.MappingName; }))
+        {
+            continue;
+        }
+
+        if (Original.Value.IsValid())
+        {
+            Restore->QueueMap(Original.Key.MappingName, Original.Key.Slot, Original.Value, false);
+        }
+        else
+        {
+            Restore->QueueUnmap(Original.Key.MappingName, Original.Key.Slot);
+        }
+    }
+    Restore->Commit(true);
+
+    UE_LOG(LogRogueRebindTransaction, Log, TEXT("URogueRebindTransaction reset benchmark, %d actions:"), Targets.Num());
+    UE_LOG(LogRogueRebindTransaction, Log, TEXT("    Per action:  %8.3f ms, %d mapping context rebuild requests"), PerActionMs, PerActionRebuilds);
+    UE_LOG(LogRogueRebindTransaction, Log, TEXT("    Transaction: %8.3f ms, %d mapping context rebuild requests (%d changes)"), TransactionMs, TransactionRebuilds, Transaction->GetNumChanges());
+
+    if (OutResult)
+    {
+        OutResult->NumActions          = Targets.Num();
+        OutResult->PerActionMs         = PerActionMs;
+        OutResult->PerActionRebuilds   = PerActionRebuilds;
+        OutResult->TransactionMs       = TransactionMs;
+        OutResult->TransactionRebuilds = TransactionRebuilds;
+        OutResult->TransactionChanges  = Transaction->GetNumChanges();
+    }
+
+    return true;
+}
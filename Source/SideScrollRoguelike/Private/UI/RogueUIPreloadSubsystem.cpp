@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "UI/RogueUIPreloadSubsystem.h"
+
+#include "CommonActivatableWidget.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Engine/WorldInitializationValues.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameMapsSettings.h"
+#include "Settings/RogueDeveloperSettings.h"
+#include "UI/RogueHUD.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RogueUIPreloadSubsystem)
+
+DEFINE_LOG_CATEGORY(LogRogueUIPreload);
+
+void URogueUIPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PreloadStartTime = FPlatformTime::Seconds();
+
+    // The HUD of a map is only known once its world exists
+    PostWorldCreationHandle = FWorldDelegates::OnPostWorldInitialization.AddUObject(this, &ThisClass::WorldInitialization);
+
+    const URogueDeveloperSettings* DeveloperSettings = GetDefault<URogueDeveloperSettings>();
+    for (const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass : DeveloperSettings->PreloadScreenClasses)
+    {
+        PreloadWidgetClass(WidgetClass);
+    }
+}
+
+void URogueUIPreloadSubsystem::Deinitialize()
+{
+    FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldCreationHandle);
+
+    for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& PreloadHandle : PreloadHandles)
+    {
+        if (PreloadHandle.Value.IsValid())
+        {
+            PreloadHandle.Value->CancelHandle();
+        }
+    }
+
+    PreloadHandles.Empty();
+
+    Super::Deinitialize();
+}
+
+void URogueUIPreloadSubsystem::PreloadWidgetClass(const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass)
+{
+    const FSoftObjectPath WidgetClassPath = WidgetClass.ToSoftObjectPath();
+    if (WidgetClassPath.IsNull() || PreloadHandles.Contains(WidgetClassPath))
+    {
+        return;
+    }
+
+    // A handle is kept for loaded classes too, so they stay in memory when whatever loaded them lets go
+    PreloadHandles.Add(WidgetClassPath, UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClassPath, FStreamableDelegate::CreateUObject(this, &ThisClass::WidgetClassLoaded, WidgetClassPath), FStreamableManager::AsyncLoadHighPriority));
+}
+
+bool URogueUIPreloadSubsystem::IsPreloadComplete() const
+{
+    for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& PreloadHandle : PreloadHandles)
+    {
+        if (PreloadHandle.Value.IsValid() && PreloadHandle.Value->IsLoadingInProgress())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void URogueUIPreloadSubsystem::WorldInitialization(UWorld* World, const FWorldInitializationValues IVS)
+{
+    if (!World || !World->IsGameWorld() || World->GetGameInstance() != GetGameInstance())
+    {
+        return;
+    }
+
+    // The world settings override wins, otherwise the project default game mode if it has been loaded already
+    TSubclassOf<AGameModeBase> GameModeClass = World->GetWorldSettings() ? World->GetWorldSettings()->DefaultGameMode : nullptr;
+    if (!GameModeClass)
+    {
+        GameModeClass = TSoftClassPtr<AGameModeBase>(FSoftObjectPath(UGameMapsSettings::GetGlobalDefaultGameMode())).Get();
+    }
+
+    PreloadHUDWidget(GameModeClass);
+}
+
+void URogueUIPreloadSubsystem::PreloadHUDWidget(TSubclassOf<AGameModeBase> GameModeClass)
+{
+    const AGameModeBase* GameMode = GameModeClass ? GameModeClass->GetDefaultObject<AGameModeBase>() : nullptr;
+    if (!GameMode || !GameMode->HUDClass || !GameMode->HUDClass->IsChildOf<ARogueHUD>())
+    {
+        return;
+    }
+
+    PreloadWidgetClass(GameMode->HUDClass->GetDefaultObject<ARogueHUD>()->GetDefaultWidgetClass());
+}
+
+void URogueUIPreloadSubsystem::WidgetClassLoaded(FSoftObjectPath WidgetClassPath)
+{
+    UE_LOG(LogRogueUIPreload, Verbose, TEXT("URogueUIPreloadSubsystem::WidgetClassLoaded %s after %.2f s."), *WidgetClassPath.ToString(), FPlatformTime::Seconds() - PreloadStartTime);
+
+    if (!WidgetClassPath.ResolveObject())
+    {
+        UE_LOG(LogRogueUIPreload, Warning, TEXT("URogueUIPreloadSubsystem::WidgetClassLoaded failed to load %s."), *WidgetClassPath.ToString());
+    }
+}
@@ -40,6 +40,47 @@ UCommonActivatableWidget* UUserInterfaceBlueprintLibrary::PushContentToLayerForP
 	return nullptr;
 }
 
+void UUserInterfaceBlueprintLibrary::PushStreamedContentToLayerForPlayer(const APlayerController* Player, FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass, const FRogueStreamedContentPushed& OnPushed)
+{
+	if (!Player || WidgetClass.IsNull())
+	{
+		UE_LOG(LogUserInterfaceBlueprintLibrary, Error, TEXT("UUserInterfaceBlueprintLibrary::PushStreamedContentToLayerForPlayer, invalid player parameter or widget class."));
+		OnPushed.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	if (ARogueHUD* RogueHUD = Player->GetHUD<ARogueHUD>())
+	{
+		if (URogueGameLayout* RootLayout = RogueHUD->GetRootLayoutWidget())
+		{
+			RootLayout->PushWidgetToLayerStackAsync(LayerName, WidgetClass, [OnPushed](UCommonActivatableWidget* NewWidget)
+			{
+				OnPushed.ExecuteIfBound(NewWidget);
+			});
+			return;
+		}
+	}
+
+	OnPushed.ExecuteIfBound(nullptr);
+}
+
+void UUserInterfaceBlueprintLibrary::ClearLayersForPlayer(const APlayerController* Player, const FGameplayTagContainer& LayerNames)
+{
+	if (!Player)
+	{
+		UE_LOG(LogUserInterfaceBlueprintLibrary, Error, TEXT("UUserInterfaceBlueprintLibrary::ClearLayersForPlayer, invalid player parameter."));
+		return;
+	}
+
+	if (ARogueHUD* RogueHUD = Player->GetHUD<ARogueHUD>())
+	{
+		if (URogueGameLayout* RootLayout = RogueHUD->GetRootLayoutWidget())
+		{
+			RootLayout->ClearLayers(LayerNames);
+		}
+	}
+}
+
 void UUserInterfaceBlueprintLibrary::SetNavigationEnabled(bool bIsNavEnabled)
 {
 	FSlateApplication::Get().GetNavigationConfig()->bTabNavigation = bIsNavEnabled;
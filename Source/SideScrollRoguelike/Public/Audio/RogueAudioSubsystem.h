@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Audio/RogueAudioTypes.h"
+#include "Containers/Ticker.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Engine/WorldInitializationValues.h"
 #include "RogueAudioSubsystem.generated.h"
@@ -17,6 +19,8 @@ struct FWorldInitializationValues;
 class UAudioComponent;
 class USoundMix;
 class USoundClass;
+class USoundWave;
+struct FStreamableHandle;
 
 // Log category for the Rogue Audio Subsystem
 DECLARE_LOG_CATEGORY_EXTERN(LogRogueAudioSubsystem, Log, All);
@@ -36,6 +40,9 @@ public:
     // Initializes the subsystem, binding relevant delegates, and sets up runtime audio data
     void Initialize(FSubsystemCollectionBase& Collection) override;
 
+    // Cancels any audio asset load still in flight
+    void Deinitialize() override;
+
     // Updates the save game object with audio system specific data
     UFUNCTION(BlueprintCallable, Category = "Rogue|Audio")
     void SaveAudioSettings();
@@ -72,9 +79,39 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rogue|Audio")
     void PlaySoundAsWorldMusic(USoundBase* Music);
 
+    // Plays a sound effect at a location on a pooled voice. Returns nullptr when the sound was culled or no voice was free.
+    // The returned component is reused by later sounds, do not keep it around.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Audio")
+    UAudioComponent* PlaySFXAtLocation(USoundBase* Sound, FVector Location, ERogueSfxCategory Category, int32 Priority = 0, float VolumeMultiplier = 1.0f, float PitchMultiplier = 1.0f);
+
+    // Plays a non-spatialized sound effect on a pooled voice. Returns nullptr when no voice was free.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Audio")
+    UAudioComponent* PlaySFX2D(USoundBase* Sound, ERogueSfxCategory Category, int32 Priority = 0, float VolumeMultiplier = 1.0f, float PitchMultiplier = 1.0f);
+
+    // Plays the sound mapped to a gameplay event in the audio event table. Rate limited per event by the table's cooldowns.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Audio", meta = (GameplayTagFilter = "Audio.Event"))
+    void PostAudioEvent(FGameplayTag EventTag, FVector Location);
+
+    // Pauses the world music regardless of the level state, e.g. while the game window is in the background
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Audio")
+    void SetWorldMusicSuspended(bool bSuspended);
+
     UObject* LoadSoftObjectPtrSynchronous(TSoftObjectPtr<UObject> SoftObjectPtr);
 
+    // Runs rapid level state and volume changes and logs the cost of each operation, see Rogue.Audio.Benchmark.
+    // Returns false when there is no world with loaded audio assets to run in.
+    bool RunAudioBenchmark(int32 Iterations);
+
 protected:
+    // Called when the audio assets from the Rogue Developer Settings have loaded. Applies anything deferred until then.
+    void AudioAssetsLoaded();
+
+    // Builds the event routes from the audio event table and starts loading their sounds
+    void BuildAudioEventRoutes();
+
+    // Called when the sounds of the audio event routes have loaded
+    void AudioEventSoundsLoaded();
+
     // Callback to be notified when the loading screen is shown/hidden
     void LoadingScreenVisibilityChanged(bool bVisible);
 
@@ -87,23 +124,67 @@ protected:
     // Takes the current audio data and applies it across sound mixers
     void UpdateMixersFromAudioData();
 
-    // Changes the volume of a mix given a sound class
+    // Stages a volume change of a mix given a sound class. Staged changes are applied together on the next frame.
     void ApplyVolumeChangeToMix(USoundClass* TargetSoundClass, float Volume, float FadeIn = 0.0f);
 
-    // Spawns the WorldMusicPlayer and starts the music defined in world settings
+    // Applies all staged volume changes to the audio device in one batch
+    bool FlushMixChanges(float DeltaTime);
+
+    // Replaces the active level state snapshot with the given one, or removes it when null
+    void ApplyLevelStateSnapshot(USoundMix* Snapshot);
+
+    // Spawns the music decks and starts the music defined in world settings
     void StartDefaultWorldMusic();
 
+    // Switches to the given music right away
     void PlayWorldMusic(USoundBase* Music);
 
-    // Pauses the world music player
-    void TogglePauseWorldMusic();
+    // Returns the deck playing the current music, may be null before any music played
+    UAudioComponent* GetActiveMusicDeck() const { return MusicDecks[ActiveMusicDeck]; }
 
-    // Stops the world music and optionally transitions to victory music
+    // Crossfades to the given music. Music that is already on the active deck resumes where it is instead of restarting.
+    // The next track is primed right away, the switch optionally waits for the next bar of the current music.
+    void TransitionToMusic(USoundBase* Music, bool bAlignToBar);
+
+    // Crossfades from the active deck to the pending music
+    bool SwitchMusicDeck(float DeltaTime);
+
+    // Fades out the active deck without starting new music
+    void FadeOutMusic();
+
+    // Seconds until the next bar of the current music, 0 without tempo information
+    float GetTimeToNextBar() const;
+
+    // Keeps track of the playback position of the active deck
+    void MusicPlaybackPercent(const UAudioComponent* Component, const USoundWave* Wave, float Percent);
+
+    // Pauses the world music player while the level is paused or the music is suspended
+    void UpdateWorldMusicPaused();
+
+    // Crossfades from the world music to the victory music on the next bar, or fades out without one
     void StartVictoryMusic();
 
-    // Stops the world music and optionally transitions to victory music
+    // Crossfades from the world music to the game over music on the next bar, or fades out without one
     void StartGameOverMusic();
 
+    // Shared implementation of PlaySFXAtLocation and PlaySFX2D. Location is null for 2D sounds.
+    UAudioComponent* PlaySFX(USoundBase* Sound, const FVector* Location, ERogueSfxCategory Category, int32 Priority, float VolumeMultiplier, float PitchMultiplier);
+
+    // Returns true when a positional sound is too far from or too far outside the camera view to be worth a voice
+    bool IsSFXCulled(const FVector& Location);
+
+    // Returns the index of a voice to play a new sound on, stealing one if needed. INDEX_NONE if nothing may be stolen.
+    int32 AcquireSFXVoice(ERogueSfxCategory Category, int32 Priority);
+
+    // Stops the lowest priority, oldest voice with at most the given priority. Optionally only considers one category.
+    int32 StealSFXVoice(const ERogueSfxCategory* Category, int32 Priority);
+
+    // Called when a pooled voice finishes playing
+    void SFXVoiceFinished(UAudioComponent* Component);
+
+    // Stops and forgets all pooled voices, their components belong to the world being replaced
+    void ReleaseSFXVoices();
+
     // Gets the Rogue game settings from GEngine
     TObjectPtr<URogueGameUserSettings> GetRogueGameSettings();
 
@@ -118,15 +199,32 @@ protected:
     // The current world's settings
     TObjectPtr<ARogueWorldSettings> CurrentWorldSettings;
 
-    // The audio component that persists between worlds and plays music.
-    // Must be a UPROPERTY so it is not garbage collected.
+    // The two audio components that persist between worlds and play music. Transitions crossfade from one deck to the other.
+    // Must be a UPROPERTY so they are not garbage collected.
+    UPROPERTY()
+    TObjectPtr<UAudioComponent> MusicDecks[2];
+
+    // Index of the deck playing the current music
+    int32 ActiveMusicDeck = 0;
+
+    // Playback position of the active deck in seconds, reported by the deck while it plays
+    float ActiveMusicPosition = 0.0f;
+
+    // The music waiting to be switched to at the next bar
     UPROPERTY()
-    TObjectPtr<UAudioComponent> WorldMusicPlayer;
+    TObjectPtr<USoundBase> PendingMusic;
+
+    // Ticker switching decks at the next bar
+    FTSTicker::FDelegateHandle MusicTransitionHandle;
 
     // The Default Mix Modifier for Audio
     UPROPERTY()
     TObjectPtr<USoundMix> DefaultSoundMixModifier;
 
+    // Ids of the audio devices the default mix has been pushed to since the current world was initialized. Kept on the game
+    // thread, the device's list of mixes belongs to the audio thread.
+    TSet<uint32> DefaultMixPushedDeviceIds;
+
     // The Main Sound Class for volume changes
     UPROPERTY()
     TObjectPtr<USoundClass> MainSoundClass;
@@ -147,6 +245,14 @@ protected:
     UPROPERTY()
     TObjectPtr<USoundBase> LevelFailMusic;
 
+    // The mix snapshot of each level state
+    UPROPERTY()
+    TMap<ELevelState, TObjectPtr<USoundMix>> LevelStateSoundMixes;
+
+    // The snapshot currently pushed to the audio device
+    UPROPERTY()
+    TObjectPtr<USoundMix> ActiveLevelStateSoundMix;
+
     // The current game instance
     TObjectPtr<URogueGameInstance> RogueGameInstance;
 
@@ -170,4 +276,58 @@ protected:
 
     // The Rogue Developer Settings
     const URogueDeveloperSettings* CurrentDeveloperSettings;
+
+    // The pooled SFX voices of the current world
+    UPROPERTY()
+    TArray<FRogueSfxVoice> SFXVoices;
+
+    // Number of pooled voices playing
+    int32 NumActiveSFXVoices = 0;
+
+    // Serial number given to the next pooled sound
+    uint64 NextSFXSerial = 0;
+
+    // Audio events by tag, built once from the audio event table
+    UPROPERTY()
+    TMap<FGameplayTag, FRogueAudioEventRoute> AudioEventRoutes;
+
+    // Handle of the load of all audio event sounds
+    TSharedPtr<FStreamableHandle> AudioEventSoundsHandle;
+
+    // A staged volume change for a sound class
+    struct FPendingMixChange
+    {
+        float Volume = 1.0f;
+        float FadeIn = 0.0f;
+    };
+
+    // Volume changes waiting for the next flush. The sound classes are referenced by the properties above.
+    TMap<USoundClass*, FPendingMixChange> PendingMixChanges;
+
+    // Ticker flushing the staged volume changes
+    FTSTicker::FDelegateHandle MixFlushTickerHandle;
+
+    // Handle of the batched audio asset load started in Initialize
+    TSharedPtr<FStreamableHandle> AudioAssetsHandle;
+
+    // Time the audio asset load was requested
+    double AudioLoadStartTime = 0.0;
+
+    // Time WorldBeginPlay started waiting on the audio asset load, 0 if it never had to
+    double AudioLoadWaitStartTime = 0.0;
+
+    // True once the audio assets have loaded
+    bool bAudioAssetsLoaded = false;
+
+    // True when the world music was requested before the audio assets loaded
+    bool bWorldMusicDeferred = false;
+
+    // True while the level is paused
+    bool bWorldMusicPausedByGame = false;
+
+    // True while the world music is suspended from outside, see SetWorldMusicSuspended
+    bool bWorldMusicSuspended = false;
+
+    // True while a loading screen is up
+    bool bWorldMusicPausedForLoading = false;
 };
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "GameplayTagContainer.h"
+
+#include "RogueAudioTypes.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+// The category of a pooled sound effect, used for per-category voice limits
+UENUM(BlueprintType)
+enum class ERogueSfxCategory : uint8
+{
+    Player,
+    Enemy,
+    Boss,
+    Cannon,
+    Pickup,
+    UI,
+    Other
+};
+
+// A reusable voice of the SFX pool
+USTRUCT()
+struct FRogueSfxVoice
+{
+    GENERATED_BODY()
+
+    // The audio component reused for every sound played on this voice
+    UPROPERTY()
+    TObjectPtr<UAudioComponent> Component;
+
+    // The category of the sound currently playing
+    ERogueSfxCategory Category = ERogueSfxCategory::Other;
+
+    // The priority of the sound currently playing. Higher priorities steal from lower ones.
+    int32 Priority = 0;
+
+    // Increases with every sound played, used to steal the oldest voice first
+    uint64 Serial = 0;
+
+    // True while the voice is playing
+    bool bActive = false;
+};
+
+// A row of the audio event table, describing what plays when a gameplay event is posted to the audio subsystem
+USTRUCT(BlueprintType)
+struct FRogueAudioEventRow : public FTableRowBase
+{
+    GENERATED_BODY()
+
+    // The event this row responds to
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event", meta = (Categories = "Audio.Event"))
+    FGameplayTag EventTag;
+
+    // The sounds to pick from. A different variation than the last one is picked whenever possible.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event")
+    TArray<TSoftObjectPtr<USoundBase>> Variations;
+
+    // The voice category used for the pooled voice limits
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event")
+    ERogueSfxCategory Category = ERogueSfxCategory::Other;
+
+    // Voice priority, higher priorities steal from lower ones
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event")
+    int32 Priority = 0;
+
+    // Minimum seconds between two plays of this event. Posts of the same event in one frame always play only once.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event", meta = (ClampMin = "0", ForceUnits = "s"))
+    float Cooldown = 0.05f;
+
+    // Random volume multiplier range
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event")
+    FVector2D VolumeRange = FVector2D(1.0f, 1.0f);
+
+    // Random pitch multiplier range
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event")
+    FVector2D PitchRange = FVector2D(1.0f, 1.0f);
+
+    // When true, the sound is played without spatialization
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio Event")
+    bool b2D = false;
+};
+
+// An audio event resolved from the event table, ready to play
+USTRUCT()
+struct FRogueAudioEventRoute
+{
+    GENERATED_BODY()
+
+    // The loaded variations
+    UPROPERTY()
+    TArray<TObjectPtr<USoundBase>> Sounds;
+
+    ERogueSfxCategory Category = ERogueSfxCategory::Other;
+    int32 Priority = 0;
+    float Cooldown = 0.0f;
+    FVector2D VolumeRange = FVector2D(1.0f, 1.0f);
+    FVector2D PitchRange = FVector2D(1.0f, 1.0f);
+    bool b2D = false;
+
+    // Rate limiting state
+    double LastPlayTime = -UE_BIG_NUMBER;
+    uint64 LastPlayFrame = MAX_uint64;
+    int32 LastVariation = INDEX_NONE;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameplayTagContainer.h"
 #include "RogueCharacterBase.generated.h"
 
 
@@ -23,13 +24,17 @@ public:
 
     // Called when the character has landed on the ground
     virtual void Landed(const FHitResult &Hit) override;
-    virtual void BeginPlay() override;
+    virtual void PostInitializeComponents() override;
 
     //--- End ACharacter overrides 
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Rogue|Character|State")
     bool IsDead() const { return CurrentHitPoints <= 0; }
 
+    // Returns the working hit point count
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Rogue|Character|State")
+    int32 GetCurrentHitPoints() const { return CurrentHitPoints; }
+
     // Applies a hit to this character
     UFUNCTION(BlueprintCallable, Category = "Rogue|Character|Combat")
     virtual void HitCharacter();
@@ -63,6 +68,17 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Rogue|Character|Status")
     int32 CurrentHitPoints = 0;
 
+    // The audio event posted when this character is hit. Clear to play nothing.
+    UPROPERTY(EditDefaultsOnly, Category = "Rogue|Character|Audio", meta = (Categories = "Audio.Event"))
+    FGameplayTag HitAudioEvent;
+
+    // The audio event posted when this character dies. Clear to play nothing.
+    UPROPERTY(EditDefaultsOnly, Category = "Rogue|Character|Audio", meta = (Categories = "Audio.Event"))
+    FGameplayTag DeathAudioEvent;
+
+    // Posts an audio event at the character's location through the audio subsystem
+    void PostAudioEvent(const FGameplayTag& EventTag) const;
+
     // C++ logic implementation for when the character dies
     UFUNCTION(BlueprintCallable, Category = "Rogue|Character|Combat")
     virtual void CharacterDeath();
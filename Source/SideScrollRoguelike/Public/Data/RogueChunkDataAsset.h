@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/RogueMapDataAsset.h"
+#include "GameplayTagContainer.h"
+#include "RogueChunkDataAsset.generated.h"
+
+/**
+ * A map data asset describing a single level chunk that the run generator can stitch together with other chunks.
+ * The chunk level is authored starting at X = 0 and extending along +X for Length units.
+ * Heights are the Z of the walkable floor at the chunk's left (entry) and right (exit) edges.
+ */
+UCLASS(BlueprintType)
+class SIDESCROLLROGUELIKE_API URogueChunkDataAsset : public URogueMapDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // The length of the chunk along the X-axis. The next chunk is placed this far to the right.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chunk", meta = (ClampMin = "1.0", ForceUnits = "cm"))
+    float Length = 2000.0f;
+
+    // The floor height where the player enters this chunk
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chunk", meta = (ForceUnits = "cm"))
+    float EntryHeight = 0.0f;
+
+    // The floor height where the player exits this chunk
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chunk", meta = (ForceUnits = "cm"))
+    float ExitHeight = 0.0f;
+
+    // Tags describing how difficult this chunk is (e.g. Chunk.Difficulty.Hard)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chunk")
+    FGameplayTagContainer DifficultyTags;
+
+    // Relative chance of this chunk being picked over other valid chunks
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chunk", meta = (ClampMin = "0.0"))
+    float SelectionWeight = 1.0f;
+};
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
+#include "Containers/Ticker.h"
 #include "LoadingProcessInterface.h"
 
 #include "RogueGameInstance.generated.h"
 
+class UActorComponent;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWindowFocusChanged, bool, bIsFocused);
 
 /**
@@ -44,8 +47,17 @@ public:
     UFUNCTION(BlueprintPure)
     bool ShouldHoldLoadingScreen() const;
 
+    // Returns true while the game window is in the background and the background policies are applied
+    UFUNCTION(BlueprintPure)
+    bool IsInBackgroundMode() const { return bInBackgroundMode; }
+
+    // Returns the average process CPU usage (percent of all cores) measured during the last time in the background
+    UFUNCTION(BlueprintPure)
+    float GetBackgroundCPUUsage() const { return BackgroundCPUUsage; }
+
     //--- GameInstance overrides
     void Init() override;
+    void Shutdown() override;
 #if WITH_EDITOR
     FGameInstancePIEResult InitializeForPlayInEditor(int32 PIEInstanceIndex, const FGameInstancePIEParameters& Params) override;
 #endif
@@ -64,10 +76,53 @@ private:
     // Binds to slate application and broadcasts an event when the focus has changed
     void WindowFocusChanged(bool bIsFocused);
 
+    // Applies the background policies from the Rogue Developer Settings
+    void EnterBackgroundMode();
+
+    // Reverts everything EnterBackgroundMode changed
+    void ExitBackgroundMode();
+
+    // Slows down the tick of cosmetic components in the current world
+    void ThrottleCosmeticComponents(float TickInterval);
+
+    // Restores the tick interval of throttled cosmetic components
+    void RestoreCosmeticComponents();
+
+    // Asks pools and caches to give memory back once the game has been in the background for a while
+    bool TrimAfterGracePeriod(float DeltaTime);
+
+    // Accumulates process CPU usage while in the background
+    bool SampleBackgroundCPU(float DeltaTime);
+
 private:
     // Whether the game instance has played the boot splash screen yet
     bool bHasPlayedBootSplash = false;
 
     // Whether or not the loading screen is being held
     bool bHoldLoadingScreen = false;
+
+    // Whether the background policies are currently applied
+    bool bInBackgroundMode = false;
+
+    // Whether the level was paused by background mode, so only that pause is undone on focus
+    bool bPausedForBackground = false;
+
+    // Original tick intervals of the components throttled by background mode
+    TMap<TWeakObjectPtr<UActorComponent>, float> ThrottledComponentIntervals;
+
+    // Ticker for trimming memory after the grace period
+    FTSTicker::FDelegateHandle TrimTickerHandle;
+
+    // Ticker sampling CPU usage while in the background
+    FTSTicker::FDelegateHandle CPUSampleTickerHandle;
+
+    // Time background mode was entered
+    double BackgroundStartTime = 0.0;
+
+    // Sum and count of the CPU usage samples taken in the background
+    double BackgroundCPUSampleSum = 0.0;
+    int32 BackgroundCPUSampleCount = 0;
+
+    // Average CPU usage of the last time in the background
+    float BackgroundCPUUsage = 0.0f;
 };
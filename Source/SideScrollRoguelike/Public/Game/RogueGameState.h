@@ -24,6 +24,8 @@ enum class ELevelState : uint8
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLevelStateChanged, ELevelState, NewLevelState);
 // Declare a delegate type which will broadcast when the game state is initialized
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGameStateInitialized);
+// Declare a native delegate type which will broadcast the remaining whole seconds each time the level timer crosses a second
+DECLARE_MULTICAST_DELEGATE_OneParam(FRemainingSecondsChanged, int32 /*RemainingSeconds*/);
 
 /**
  *
@@ -62,6 +64,12 @@ public:
     // State handling for ready state entry. When the game is initialized but not yet started.
     void HandleReady();
 
+    // Returns the current simple state of the level
+    ELevelState GetLevelState() const { return LevelState; }
+
+    // Returns the time left rounded up to whole seconds, the value shown on the HUD
+    int32 GetRemainingSeconds() const { return FMath::CeilToInt(RemainingTime); }
+
     // Pauses the level state
     UFUNCTION(BlueprintCallable)
     void PauseGame();
@@ -83,6 +91,9 @@ public:
     UPROPERTY(BlueprintAssignable)
     FLevelStateChanged OnLevelStateChanged;
 
+    // When the level timer crosses a whole second, so the HUD does not have to poll RemainingTime every frame
+    FRemainingSecondsChanged OnRemainingSecondsChanged;
+
 protected:
     // Called by the game mode when play has started
     virtual void HandleBeginPlay() override;
@@ -111,6 +122,12 @@ protected:
     UPROPERTY(Transient, BlueprintReadOnly)
     ELevelState LevelState = ELevelState::Preload;
 
+    // The remaining seconds last broadcast through OnRemainingSecondsChanged
+    int32 LastBroadcastRemainingSeconds = INDEX_NONE;
+
+    // Broadcasts OnRemainingSecondsChanged if the remaining time crossed a whole second
+    void BroadcastRemainingSeconds();
+
 private:
     // Handle for the timer we set in BossDefeated()
     FTimerHandle TimerHandle_BossDefeatedDelay;
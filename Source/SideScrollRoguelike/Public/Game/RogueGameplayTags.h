@@ -11,4 +11,10 @@ namespace Tags
     UE_DECLARE_GAMEPLAY_TAG_EXTERN(UI_Layer_Menu);
     UE_DECLARE_GAMEPLAY_TAG_EXTERN(UI_Layer_Modal);
 
+    UE_DECLARE_GAMEPLAY_TAG_EXTERN(Audio_Event_Character_Hit);
+    UE_DECLARE_GAMEPLAY_TAG_EXTERN(Audio_Event_Character_Death);
+    UE_DECLARE_GAMEPLAY_TAG_EXTERN(Audio_Event_Player_EnemyBounce);
+    UE_DECLARE_GAMEPLAY_TAG_EXTERN(Audio_Event_Player_Pickup_Health);
+    UE_DECLARE_GAMEPLAY_TAG_EXTERN(Audio_Event_Player_Pickup_Speed);
+
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RogueLevelPrefetchSubsystem.generated.h"
+
+class AGameStateBase;
+class ARogueGameState;
+class URogueMapDataAsset;
+enum class ELevelState : uint8;
+struct FStreamableHandle;
+struct FWorldInitializationValues;
+
+// Log category for the Rogue Level Prefetch Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueLevelPrefetch, Log, All);
+
+/**
+ *
+ * Preloads the package (and dependencies) of the level that follows the current one while it is being played.
+ * Once the current level reaches ELevelState::Running, the next level from the world settings is requested at low priority
+ * and kept in memory until the next map has been loaded, so the travel itself finds everything already resident.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueLevelPrefetchSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //--- USubsystem overrides
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+    void Deinitialize() override;
+    //--- End USubsystem
+
+    // Starts preloading the given level. Replaces any prefetch already in progress.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Level")
+    void PrefetchLevel(TSoftObjectPtr<URogueMapDataAsset> MapData);
+
+    // Drops the current prefetch and releases anything it loaded
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Level")
+    void CancelPrefetch();
+
+    // Returns true once the prefetched level and all of its dependencies are in memory
+    UFUNCTION(BlueprintPure, Category = "Rogue|Level")
+    bool IsPrefetchComplete() const;
+
+protected:
+    // Callback for world initialization
+    void WorldInitialization(UWorld* World, const FWorldInitializationValues IVS);
+
+    // Callback for when the game state of the current world is set. This happens before the game mode starts play,
+    // so the first Running of the level is seen as it happens.
+    void GameStateSet(AGameStateBase* GameState);
+
+    // Callback for when a map has finished loading. The prefetch has served its purpose by then.
+    void PostLoadMap(UWorld* World);
+
+    // Reacts to changes in the game state
+    // Must be a UFUNCTION as this is bound to a dynamic mulitcast delegate
+    UFUNCTION()
+    void GameStateChanged(ELevelState NewLevelState);
+
+    // Called when the map data asset has loaded, starts loading its level
+    void MapDataLoaded();
+
+    // Called when the level package and its dependencies have loaded
+    void LevelLoaded();
+
+    // Returns true when there is enough free memory to start a prefetch
+    bool HasMemoryBudget() const;
+
+protected:
+    // The current world
+    TWeakObjectPtr<UWorld> CurrentWorld;
+
+    // The current Rogue game state for a world
+    TWeakObjectPtr<ARogueGameState> RogueGameState;
+
+    // True once the current level tried to prefetch its next level. A prefetch that was cancelled for memory is not retried.
+    bool bAttemptedPrefetchForLevel = false;
+
+    // The map data of the level being prefetched
+    TSoftObjectPtr<URogueMapDataAsset> PrefetchedMapData;
+
+    // Handle for the map data asset load
+    TSharedPtr<FStreamableHandle> MapDataHandle;
+
+    // Handle keeping the prefetched level package and its dependencies in memory
+    TSharedPtr<FStreamableHandle> LevelHandle;
+
+    // Used physical memory when the level load started, to measure what the prefetch costs
+    uint64 UsedPhysicalAtLevelLoadStart = 0;
+
+    // Time the prefetch started, for logging
+    double PrefetchStartTime = 0.0;
+
+    // Delegate handle for world creation
+    FDelegateHandle PostWorldCreationHandle;
+
+    // Delegate handle for map load completion
+    FDelegateHandle PostLoadMapHandle;
+
+    // Delegate handle for memory trim requests
+    FDelegateHandle MemoryTrimHandle;
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A small, fast PCG32 random number generator (https://www.pcg-random.org).
+ * Each stream is fully described by its 128 bits of state, so copies are independent and can be handed to worker threads.
+ * Streams are not thread-safe themselves, give every thread its own copy.
+ */
+struct FRogueRandomStream
+{
+public:
+    FRogueRandomStream() = default;
+
+    // Creates a stream from a seed. Streams with the same seed but a different sequence never overlap.
+    explicit FRogueRandomStream(uint64 Seed, uint64 Sequence = 0)
+    {
+        Reset(Seed, Sequence);
+    }
+
+    // Restarts the stream from a seed and sequence
+    void Reset(uint64 Seed, uint64 Sequence = 0)
+    {
+        State     = 0;
+        Increment = (Sequence << 1u) | 1u;
+        NextUInt32();
+        State += Seed;
+        NextUInt32();
+    }
+
+    // Returns the next 32 random bits
+    FORCEINLINE uint32 NextUInt32()
+    {
+        const uint64 OldState = State;
+        State                 = OldState * 6364136223846793005ULL + Increment;
+
+        const uint32 XorShifted = uint32(((OldState >> 18u) ^ OldState) >> 27u);
+        const uint32 Rotation   = uint32(OldState >> 59u);
+        return (XorShifted >> Rotation) | (XorShifted << ((~Rotation + 1u) & 31u));
+    }
+
+    // Returns a float in [0, 1)
+    FORCEINLINE float FRand()
+    {
+        return float(NextUInt32() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Returns an integer in [0, Max). Returns 0 when Max <= 0.
+    FORCEINLINE int32 RandHelper(int32 Max)
+    {
+        return Max > 0 ? int32((uint64(NextUInt32()) * uint64(Max)) >> 32) : 0;
+    }
+
+    // Returns an integer in [Min, Max]
+    FORCEINLINE int32 RandRange(int32 Min, int32 Max)
+    {
+        return Max > Min ? Min + RandHelper(Max - Min + 1) : Min;
+    }
+
+    // Returns a float in [Min, Max)
+    FORCEINLINE float FRandRange(float Min, float Max)
+    {
+        return Min + (Max - Min) * FRand();
+    }
+
+    // Returns true with the given probability
+    FORCEINLINE bool RandBool(float Probability = 0.5f)
+    {
+        return FRand() < Probability;
+    }
+
+private:
+    // The internal state, advanced on every draw
+    uint64 State = 0x853c49e6748fea9bULL;
+
+    // Selects the sequence. Always odd.
+    uint64 Increment = 0xda3e39cb94b95bdbULL;
+};
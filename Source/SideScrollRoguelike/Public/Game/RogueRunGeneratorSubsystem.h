@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "LoadingProcessInterface.h"
+#include "RogueRunGeneratorSubsystem.generated.h"
+
+class ULevelStreamingDynamic;
+class URogueChunkDataAsset;
+
+// Log category for the Rogue Run Generator
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueRunGenerator, Log, All);
+
+// The inputs used to build a run out of level chunks
+USTRUCT(BlueprintType)
+struct SIDESCROLLROGUELIKE_API FRogueRunGenerationParams
+{
+    GENERATED_BODY()
+
+public:
+    // The seed for chunk selection. The same seed and pool always produce the same layout.
+    // When zero, the layout is derived from the seed of the current run (see URogueRunSeedSubsystem).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rogue|Run")
+    int32 Seed = 0;
+
+    // The chunks that the generator is allowed to pick from
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rogue|Run")
+    TArray<TObjectPtr<URogueChunkDataAsset>> ChunkPool;
+
+    // How many chunks make up the run
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rogue|Run", meta = (ClampMin = "1"))
+    int32 NumChunks = 8;
+
+    // When not empty, only chunks with at least one of these tags are picked
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rogue|Run")
+    FGameplayTagContainer DifficultyTags;
+
+    // The largest floor height difference allowed between a chunk's exit and the next chunk's entry
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rogue|Run", meta = (ClampMin = "0.0", ForceUnits = "cm"))
+    float MaxHeightStep = 200.0f;
+
+    // World location of the first chunk's origin
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rogue|Run")
+    FVector Origin = FVector::ZeroVector;
+};
+
+// A chunk chosen by the generator and where it was placed in the world
+USTRUCT(BlueprintType)
+struct SIDESCROLLROGUELIKE_API FRogueChunkPlacement
+{
+    GENERATED_BODY()
+
+public:
+    // The chunk that was placed
+    UPROPERTY(BlueprintReadOnly, Category = "Rogue|Run")
+    TObjectPtr<URogueChunkDataAsset> Chunk;
+
+    // The world location of the chunk's origin
+    UPROPERTY(BlueprintReadOnly, Category = "Rogue|Run")
+    FVector Location = FVector::ZeroVector;
+};
+
+// A single slot of a run layout as produced by the worker thread
+struct FRogueChunkLayoutSlot
+{
+    // Index of the chunk in the generation request's chunk pool
+    int32 PoolIndex = INDEX_NONE;
+
+    // The world location of the chunk's origin
+    FVector Location = FVector::ZeroVector;
+};
+
+// Broadcast once every chunk of a generated run has been requested for streaming
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRunLayoutStreamed, const TArray<FRogueChunkPlacement>&, Placements);
+
+/**
+ *
+ * Builds roguelike runs by stitching chunk sublevels together along the X-axis.
+ * Chunk selection and layout run on a worker thread from a plain data snapshot of the chunk pool,
+ * so the game thread only issues the final level streaming requests.
+ * Holds the loading screen until every chunk of the run has been streamed in.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueRunGeneratorSubsystem : public UWorldSubsystem, public ILoadingProcessInterface
+{
+    GENERATED_BODY()
+
+public:
+    //--- UWorldSubsystem overrides
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+    void Deinitialize() override;
+    //--- End UWorldSubsystem
+
+    //--- ILoadingProcessInterface overrides
+    bool ShouldShowLoadingScreen(FString& OutReason) const override;
+    //--- End ILoadingProcessInterface
+
+    // Starts generating a run. Any previously generated run is unloaded first.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Run")
+    void GenerateRun(const FRogueRunGenerationParams& Params);
+
+    // Unloads all chunk levels of the current run
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Run")
+    void UnloadRun();
+
+    // Returns true while the layout is being built on the worker thread or chunks are still streaming in
+    UFUNCTION(BlueprintPure, Category = "Rogue|Run")
+    bool IsGeneratingRun() const;
+
+    // Returns the placements of the current run
+    UFUNCTION(BlueprintPure, Category = "Rogue|Run")
+    const TArray<FRogueChunkPlacement>& GetPlacements() const { return Placements; }
+
+    // Broadcast once all chunks of the run have been requested for streaming
+    UPROPERTY(BlueprintAssignable)
+    FOnRunLayoutStreamed OnRunLayoutStreamed;
+
+protected:
+    //--- UWorldSubsystem overrides
+    bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    //--- End UWorldSubsystem
+
+    // Called on the game thread with the layout built by the worker. Issues the streaming requests.
+    void StreamLayout(uint32 RequestId, const TArray<FRogueChunkLayoutSlot>& Layout);
+
+    // Callback for when a chunk level of the run is loaded or shown
+    // Must be a UFUNCTION as this is bound to dynamic multicast delegates
+    UFUNCTION()
+    void ChunkStreamingChanged();
+
+    // Drops chunks that failed to load and stops waiting for chunks once streaming timed out
+    void UpdateChunkStreaming();
+
+    // Returns true if the chunk is still expected to become visible
+    static bool IsChunkPending(const ULevelStreamingDynamic* StreamedChunk);
+
+    // Asks the loading screen manager to re-check ShouldShowLoadingScreen, called whenever the layout or streaming state changes
+    void MarkLoadingScreenStateDirty() const;
+
+protected:
+    // The placements of the current run
+    UPROPERTY(Transient)
+    TArray<FRogueChunkPlacement> Placements;
+
+    // The streamed chunk levels of the current run
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<ULevelStreamingDynamic>> StreamedChunks;
+
+    // The chunk pool of the request in flight. The worker only sees plain copies, this maps its results back to assets.
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<URogueChunkDataAsset>> PendingChunkPool;
+
+    // Incremented per request so results of superseded requests are discarded
+    uint32 CurrentRequestId = 0;
+
+    // True while the worker thread is building a layout
+    bool bLayoutInFlight = false;
+
+    // True once the chunks of the run took longer than ChunkStreamingTimeoutSeconds, they are not waited on anymore
+    bool bChunkStreamingTimedOut = false;
+
+    // When the chunks of the run were requested
+    double ChunkStreamingStartTime = 0.0;
+
+    // Timer checking the chunks for failures and the timeout while they stream in
+    FTimerHandle ChunkStreamingTimerHandle;
+};
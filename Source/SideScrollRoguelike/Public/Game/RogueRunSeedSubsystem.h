@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Game/RogueRandomStream.h"
+#include <atomic>
+#include "RogueRunSeedSubsystem.generated.h"
+
+// Log category for the Rogue Run Seed Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueRunSeed, Log, All);
+
+/**
+ *
+ * Owns the seed of the current run and hands out named random streams derived from it.
+ * The same run seed and stream name always produce the same sequence, and different names never share one,
+ * so content generation and enemy behavior can be reproduced by replaying a seed (see -RogueRunSeed=).
+ *
+ * Native code should call MakeStream once and keep the copy: drawing from it is a handful of integer operations
+ * and needs no locking, which makes it suitable for hot loops and worker threads.
+ * The Blueprint functions draw from shared named streams and are guarded by a lock.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueRunSeedSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Broadcast on the game thread when a new run seed is set
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnRunSeedChanged, uint64);
+
+    //--- USubsystem overrides
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+    //--- End USubsystem
+
+    // Starts a new run with the given seed
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Random")
+    void StartRun(int64 Seed);
+
+    // Starts a new run with a random seed
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Random")
+    void StartRandomRun();
+
+    // Returns the seed of the current run
+    UFUNCTION(BlueprintPure, Category = "Rogue|Random")
+    int64 GetRunSeed() const { return int64(RunSeed.load()); }
+
+    // Returns a new copy of the named stream, positioned at its start. Safe to call from any thread.
+    FRogueRandomStream MakeStream(FName StreamName) const;
+
+    // Returns an integer in [Min, Max] from the shared named stream
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Random")
+    int32 RandomIntegerInRange(FName StreamName, int32 Min, int32 Max);
+
+    // Returns a float in [Min, Max) from the shared named stream
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Random")
+    float RandomFloatInRange(FName StreamName, float Min, float Max);
+
+    // Returns true with the given probability from the shared named stream
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Random")
+    bool RandomBoolWithProbability(FName StreamName, float Probability = 0.5f);
+
+    // Delegate broadcast when a new run seed is set
+    FOnRunSeedChanged OnRunSeedChanged;
+
+protected:
+    // Finds or creates the shared stream for a name. StreamsLock must be held.
+    FRogueRandomStream& GetSharedStream(FName StreamName);
+
+    // Records the seed where crash reports and logs can pick it up
+    void PublishRunSeed() const;
+
+protected:
+    // The seed of the current run. Atomic as MakeStream reads it from worker threads while StartRun writes it.
+    std::atomic<uint64> RunSeed = 0;
+
+    // Streams used by the Blueprint functions, advanced on every draw
+    TMap<FName, FRogueRandomStream> SharedStreams;
+
+    // Guards SharedStreams
+    FCriticalSection StreamsLock;
+};
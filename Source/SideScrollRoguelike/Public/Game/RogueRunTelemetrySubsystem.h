@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "RogueRunTelemetrySubsystem.generated.h"
+
+class AGameStateBase;
+enum class ELevelState : uint8;
+struct FWorldInitializationValues;
+
+// Log category for the Rogue Run Telemetry Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueRunTelemetry, Log, All);
+
+/**
+ *
+ * Records per-run performance so hitches can be lined up with what was happening in the game.
+ * A run starts when the level first enters ELevelState::Running and ends on GameOver, Victory or when the world goes away.
+ *
+ * Every frame of a run writes the game thread time to the "RogueRun" CSV profiler category. At a fixed interval it also
+ * samples actor counts, ticking actors per class and memory. Level state changes are written as CSV events, Insights
+ * bookmarks and events on the "RogueRun" trace channel (enable with -trace=default,RogueRun).
+ * A summary of each run is logged when it ends.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueRunTelemetrySubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    //--- USubsystem overrides
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+    void Deinitialize() override;
+    //--- End USubsystem
+
+    //--- FTickableObjectBase overrides
+    void Tick(float DeltaTime) override;
+    ETickableTickType GetTickableTickType() const override;
+    bool IsTickable() const override;
+    bool IsTickableWhenPaused() const override { return true; }
+    TStatId GetStatId() const override;
+    UWorld* GetTickableGameObjectWorld() const override;
+    //--- End FTickableObjectBase
+
+    // Returns true while a run is being recorded
+    UFUNCTION(BlueprintPure, Category = "Rogue|Telemetry")
+    bool IsRecordingRun() const { return bRunActive; }
+
+protected:
+    // Callback for world initialization
+    void WorldInitialization(UWorld* World, const FWorldInitializationValues IVS);
+
+    // Callback for when the game state of the current world is set. This happens before the game mode starts play,
+    // so the first Running of the level is seen as it happens.
+    void GameStateSet(AGameStateBase* GameState);
+
+    // Callback for world cleanup, ends any run still in progress
+    void WorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    // Reacts to changes in the game state
+    // Must be a UFUNCTION as this is bound to a dynamic mulitcast delegate
+    UFUNCTION()
+    void GameStateChanged(ELevelState NewLevelState);
+
+    // Starts recording a new run
+    void BeginRun();
+
+    // Stops recording and logs the run summary
+    void EndRun(const TCHAR* Reason);
+
+    // Samples actor counts, ticking actors per class and memory
+    void SampleWorld();
+
+    // Records a marker in every output so it can be found on the timelines
+    void RecordEvent(const FString& EventName) const;
+
+protected:
+    // Running totals for the current run
+    struct FRunStats
+    {
+        double StartTime = 0.0;
+        uint64 Frames = 0;
+        uint64 Hitches = 0;
+        double TotalGameThreadMs = 0.0;
+        double PeakGameThreadMs = 0.0;
+        int32 PeakActorCount = 0;
+        uint64 PeakUsedPhysical = 0;
+    };
+
+    // The current world
+    TWeakObjectPtr<UWorld> CurrentWorld;
+
+    // Stats of the run being recorded
+    FRunStats RunStats;
+
+    // Counter used to give every run its own number in the outputs
+    int32 RunIndex = 0;
+
+    // CSV stat names of the classes seen ticking, built once per class
+    TMap<TObjectKey<UClass>, FName> TickStatNames;
+
+    // Seconds until the next world sample
+    float TimeUntilNextSample = 0.0f;
+
+    // True while a run is being recorded
+    bool bRunActive = false;
+
+    // Delegate handle for world creation
+    FDelegateHandle PostWorldCreationHandle;
+
+    // Delegate handle for world cleanup
+    FDelegateHandle PostWorldCleanupHandle;
+};
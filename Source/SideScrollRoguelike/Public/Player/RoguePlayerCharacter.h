@@ -26,6 +26,8 @@ public:
     // Hit point added delegate
     DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnHitpointsAdded);
 
+    ARoguePlayerCharacter();
+
     // When true, the player wants to jump
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Rogue|Input")
     bool IsJumpInputActive() const { return bPressedJump; }
@@ -111,6 +113,18 @@ protected:
     // When true, the player is invulnerable to incoming hits
     bool bHitInvulnerable;
 
+    // The audio event posted when the player bounces off an enemy
+    UPROPERTY(EditDefaultsOnly, Category = "Rogue|Character|Audio", meta = (Categories = "Audio.Event"))
+    FGameplayTag EnemyBounceAudioEvent;
+
+    // The audio event posted when the player picks up hit points
+    UPROPERTY(EditDefaultsOnly, Category = "Rogue|Character|Audio", meta = (Categories = "Audio.Event"))
+    FGameplayTag HealthPickupAudioEvent;
+
+    // The audio event posted when the player picks up a speed powerup
+    UPROPERTY(EditDefaultsOnly, Category = "Rogue|Character|Audio", meta = (Categories = "Audio.Event"))
+    FGameplayTag SpeedPickupAudioEvent;
+
     // The default collision response type for the enemy collision object channel
     ECollisionResponse DefaultEnemyCollisionResponseType;
 
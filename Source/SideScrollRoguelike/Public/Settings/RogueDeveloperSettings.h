@@ -3,11 +3,17 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Audio/RogueAudioTypes.h"
 #include "Engine/DeveloperSettings.h"
+#include "GameplayTagContainer.h"
 #include "RogueDeveloperSettings.generated.h"
 
+class UCommonActivatableWidget;
+class UDataTable;
 class USoundMix;
 class USoundClass;
+class URogueInputSelector;
+enum class ELevelState : uint8;
 
 /**
  * 
@@ -59,6 +65,11 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Rogue Audio Settings|Default Classes")
 	TSoftObjectPtr<USoundClass> SFXSoundClass;
 
+	// The (optional) mix snapshot for each level state, e.g. ducking SFX while paused or filtering on game over.
+	// Only one snapshot is active at a time, it is pushed and popped as a whole and interpolates with its own fade times.
+	UPROPERTY(Config, EditAnywhere, Category = "Rogue Audio Settings|Snapshots")
+	TMap<ELevelState, TSoftObjectPtr<USoundMix>> LevelStateSoundMixes;
+
 	// The (optional) victory music for the audio subsystem to play for a world
 	UPROPERTY(Config, EditAnywhere, Category = "Rogue Audio Settings|Default Music")
 	TSoftObjectPtr<USoundBase> LevelCompleteMusic; 
@@ -67,6 +78,100 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category="Rogue Audio Settings|Default Music")
 	TSoftObjectPtr<USoundBase> LevelFailMusic;
 
+	// Duration of the crossfade between two music tracks
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Audio Settings|Default Music", meta=(ClampMin="0", ForceUnits="s"))
+	float MusicCrossfadeSeconds = 1.5f;
+
+	// Maps gameplay audio events to sounds, see FRogueAudioEventRow
+	UPROPERTY(Config, EditAnywhere, Category = "Rogue Audio Settings|Events", meta = (RequiredAssetDataTags = "RowStructure=/Script/SideScrollRoguelike.RogueAudioEventRow"))
+	TSoftObjectPtr<UDataTable> AudioEventTable;
+
+	// Maximum number of pooled SFX voices playing at once
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Audio Settings|SFX Voices", meta=(ClampMin="1"))
+	int32 SfxVoiceBudget = 24;
+
+	// Maximum number of voices per SFX category. Categories without an entry are only limited by the voice budget.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Audio Settings|SFX Voices")
+	TMap<ERogueSfxCategory, int32> SfxCategoryVoiceLimits = {
+		{ERogueSfxCategory::Player, 6},
+		{ERogueSfxCategory::Enemy, 8},
+		{ERogueSfxCategory::Boss, 4},
+		{ERogueSfxCategory::Cannon, 4},
+		{ERogueSfxCategory::Pickup, 3},
+		{ERogueSfxCategory::UI, 4}};
+
+	// Positional SFX further than this from the camera are not played. 0 disables the check.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Audio Settings|SFX Voices", meta=(ClampMin="0", ForceUnits="cm"))
+	float SfxCullDistance = 4000.0f;
+
+	// Positional SFX further off screen than this fraction of the viewport are not played. Negative disables the check.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Audio Settings|SFX Voices")
+	float SfxOffscreenCullMargin = 0.25f;
+
+	// When true, the next level is preloaded in the background once the current level is running
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Level Settings|Prefetch")
+	bool bEnableLevelPrefetch = true;
+
+	// Memory a level prefetch may use. Prefetching is skipped when less than this is free and dropped if the level grows past it.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Level Settings|Prefetch", meta=(ClampMin="0", ForceUnits="MB", EditCondition="bEnableLevelPrefetch"))
+	int32 LevelPrefetchMemoryBudgetMB = 512;
+
+	// Async load priority of level prefetches. Kept at the default (lowest) priority so gameplay loads are never starved.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Level Settings|Prefetch", meta=(EditCondition="bEnableLevelPrefetch"))
+	int32 LevelPrefetchPriority = 0;
+
+	// Longest the run generator holds the loading screen for chunks to stream in. Chunks still missing are logged and no longer waited on.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Level Settings|Run Generator", meta=(ClampMin="1", ForceUnits="s"))
+	float ChunkStreamingTimeoutSeconds = 30.0f;
+
+	// Seconds without further changes before user settings are written to disk. Every change restarts the wait.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Settings Persistence", meta=(ClampMin="0", ForceUnits="s"))
+	float SettingsSaveDebounceSeconds = 0.5f;
+
+	// Longest a requested save may be held back by further changes, e.g. while a slider is dragged
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Settings Persistence", meta=(ClampMin="0", ForceUnits="s"))
+	float SettingsSaveMaxDelaySeconds = 5.0f;
+
+	// Frame rate cap while the game window is in the background. 0 leaves the frame rate uncapped.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Background Settings", meta=(ClampMin="0", ForceUnits="Hz"))
+	float BackgroundMaxFPS = 10.0f;
+
+	// When true, a running level is paused while the game window is in the background
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Background Settings")
+	bool bPauseGameInBackground = true;
+
+	// When true, the world music is paused while the game window is in the background
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Background Settings")
+	bool bSuspendMusicInBackground = true;
+
+	// Tick interval of cosmetic components (particle systems and components tagged with CosmeticComponentTag) in the background. 0 leaves them untouched.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Background Settings", meta=(ClampMin="0", ForceUnits="s"))
+	float BackgroundCosmeticTickInterval = 0.5f;
+
+	// Component tag marking components as cosmetic for background throttling
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Background Settings")
+	FName CosmeticComponentTag = TEXT("Cosmetic");
+
+	// Seconds in the background before pools and caches are asked to trim their memory. 0 disables trimming.
+	UPROPERTY(Config, EditAnywhere, Category="Rogue Background Settings", meta=(ClampMin="0", ForceUnits="s"))
+	float BackgroundTrimDelaySeconds = 30.0f;
+
+	// Screen classes loaded when the game starts and kept in memory, so pushing them never waits on a load
+	UPROPERTY(Config, EditAnywhere, Category="Rogue UI Settings|Preload")
+	TArray<TSoftClassPtr<UCommonActivatableWidget>> PreloadScreenClasses;
+
+	// The screen pushed and popped by Rogue.UI.Benchmark
+	UPROPERTY(Config, EditAnywhere, Category="Rogue UI Settings|Benchmark")
+	TSoftClassPtr<UCommonActivatableWidget> UIBenchmarkScreenClass;
+
+	// The layer Rogue.UI.Benchmark pushes its screen onto, the menu layer when not set
+	UPROPERTY(Config, EditAnywhere, Category="Rogue UI Settings|Benchmark", meta=(Categories="UI.Layer"))
+	FGameplayTag UIBenchmarkLayerName;
+
+	// The input selector Rogue.UI.Benchmark fills its settings list with
+	UPROPERTY(Config, EditAnywhere, Category="Rogue UI Settings|Benchmark")
+	TSoftClassPtr<URogueInputSelector> UIBenchmarkInputSelectorClass;
+
 	// An editor time toggle for skipping the logo train when launching from the main menu in editor
 	UPROPERTY(Config, EditAnywhere, Category="Rogue Editor Settings")
 	bool bSkipLogoTrain; 
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "RogueSettingsPersistenceSubsystem.generated.h"
+
+class UEnhancedInputUserSettings;
+
+// Log category for the Rogue Settings Persistence Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueSettingsPersistence, Log, All);
+
+/**
+ *
+ * Writes user settings to disk without stalling the game thread.
+ * Save requests only mark settings as dirty. The actual save happens once no new request came in for the debounce window
+ * (capped by a maximum delay), so dragging a volume slider or rebinding several keys results in a single write.
+ *
+ * Game user settings are snapshotted on the game thread and the ini is written on a background task.
+ * Enhanced Input key profiles are saved with their own async save game path.
+ * Anything still dirty is written synchronously when the game instance shuts down.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueSettingsPersistenceSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //--- USubsystem overrides
+    void Deinitialize() override;
+    //--- End USubsystem
+
+    // Requests a save of the game user settings (graphics, audio volumes)
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Settings")
+    void RequestSaveGameUserSettings();
+
+    // Requests a save of an Enhanced Input key profile
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Settings")
+    void RequestSaveInputSettings(UEnhancedInputUserSettings* InputSettings);
+
+    // Writes everything that is dirty now instead of waiting for the debounce window
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Settings")
+    void FlushPendingSaves();
+
+    // Returns true while a save is waiting for the debounce window to pass
+    UFUNCTION(BlueprintPure, Category = "Rogue|Settings")
+    bool HasPendingSaves() const;
+
+protected:
+    // Starts or restarts the debounce window
+    void ScheduleSave();
+
+    // Ticker callback for when the debounce window has passed
+    bool DebouncedSave(float DeltaTime);
+
+    // Writes the game user settings, on a background task unless bSynchronous is set
+    void SaveGameUserSettings(bool bSynchronous);
+
+    // Saves the dirty Enhanced Input key profiles
+    void SaveInputSettings(bool bSynchronous);
+
+protected:
+    // True when the game user settings changed since the last save
+    bool bGameUserSettingsDirty = false;
+
+    // Enhanced Input settings with unsaved changes
+    TArray<TWeakObjectPtr<UEnhancedInputUserSettings>> DirtyInputSettings;
+
+    // Ticker for the debounce window
+    FTSTicker::FDelegateHandle SaveTickerHandle;
+
+    // Time of the first request not saved yet, used for the maximum delay
+    double FirstPendingRequestTime = 0.0;
+
+    // The last ini write started on a background task. New writes wait for it so they land in order.
+    UE::Tasks::FTask PendingWriteTask;
+};
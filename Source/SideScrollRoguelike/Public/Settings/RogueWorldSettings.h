@@ -7,6 +7,8 @@
 #include "Camera/RogueCameraTypes.h"
 #include "RogueWorldSettings.generated.h"
 
+class URogueMapDataAsset;
+
 
 
 /**
@@ -25,6 +27,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category="Rogue|Audio|Sounds")
 	TObjectPtr<USoundBase> WorldMusic; 
 
+	// Tempo of the world music. Music transitions wait for the next bar when set, 0 switches immediately.
+	UPROPERTY(EditDefaultsOnly, Category="Rogue|Audio|Sounds", meta=(ClampMin="0"))
+	float WorldMusicBPM = 0.0f;
+
+	// Beats per bar of the world music, used with WorldMusicBPM
+	UPROPERTY(EditDefaultsOnly, Category="Rogue|Audio|Sounds", meta=(ClampMin="1"))
+	int32 WorldMusicBeatsPerBar = 4;
+
 	// The default camera actor class that should spawn in the world as part of the camera subsystem 
 	// (Can be 'None') 
 	UPROPERTY(EditDefaultsOnly, Category="Rogue|Camera")
@@ -42,4 +52,9 @@ public:
 	// The upper bound at which the camera will stop following player Z 
 	UPROPERTY(EditDefaultsOnly, Category="Rogue|Camera")
 	float CutoffUpperBoundZ = 750.0f; 	
+
+	// The level that follows this one. Preloaded in the background while this level is running.
+	// (Can be 'None')
+	UPROPERTY(EditDefaultsOnly, Category="Rogue|Level")
+	TSoftObjectPtr<URogueMapDataAsset> NextLevel;
 };
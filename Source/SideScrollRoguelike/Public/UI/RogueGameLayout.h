@@ -6,12 +6,26 @@
 #include "CommonUserWidget.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 #include "GameplayTagContainer.h"
+#include "UI/RogueUITypes.h"
+#include "UObject/ObjectKey.h"
 #include "RogueGameLayout.generated.h"
 
+class APlayerController;
+struct FStreamableHandle;
+
+// Log category for the Rogue Game Layout
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueGameLayout, Log, All);
+
 /**
  * This UI widget is the root widget we are using in our game.
  * It contains a list of UI layers (containers) where we can push our "activatable" widgets onto.
  * At any given time only one widget per layer is being displayed.
+ *
+ * Each layer keeps the widgets that left it in its own pool (CommonUI's GeneratedWidgetsPool) and hands them out again on
+ * the next push of the same class. Widgets are reused as they were left, so screens should set themselves up in
+ * OnActivated rather than in OnInitialized.
+ *
+ * The layout remembers which layer each pushed widget went onto, so removing a widget does not have to search every layer.
  */
 UCLASS(Abstract, BlueprintType, meta = (DisableNativeTick))
 class SIDESCROLLROGUELIKE_API URogueGameLayout : public UCommonUserWidget
@@ -32,27 +46,75 @@ public:
     {
         static_assert(TIsDerivedFrom<ActivatableWidgetT, UCommonActivatableWidget>::IsDerived, "Only CommonActivatableWidgets can be used here");
 
-        if (UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName))
+        UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName);
+        if (!Layer)
+        {
+            return nullptr;
+        }
+
+        ActivatableWidgetT* Widget = Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
+        if (Widget)
         {
-            return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
+            IndexWidget(LayerName, *Widget);
         }
 
-        return nullptr;
+        return Widget;
     }
 
+    // Pushes a widget of a soft class onto the layer, streaming the class in first when it is not loaded. OnPushed gets the
+    // pushed widget, or null when the class could not be loaded or there is no such layer. Returns the handle of the load, if any.
+    TSharedPtr<FStreamableHandle> PushWidgetToLayerStackAsync(FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass, TFunction<void(UCommonActivatableWidget*)> OnPushed);
+
+    // What RunFrameCostBenchmark found besides the timings it logs
+    struct FFrameCostBenchmarkResult
+    {
+        int32 Iterations           = 0;
+        int32 NumSelectors         = 0;
+        int32 PooledPushesReused   = 0;
+        int32 ColdPushesReused     = 0;
+        int32 ScreensLeftOnLayer   = 0;
+        int32 SelectorsInitialized = 0;
+    };
+
+    // Pushes and pops the benchmark screen on the player's root layout, once reused from the layer's widget pool and once
+    // freshly created with CreateWidget, builds a list of input selectors for the player's key profile and logs the cost and
+    // UObjects created by each operation. Returns false when there is nothing to measure. See Rogue.UI.Benchmark and the Rogue.UI.Benchmark automation test.
+    static bool RunFrameCostBenchmark(APlayerController* PlayerController, int32 Iterations, int32 NumSelectors, FFrameCostBenchmarkResult* OutResult = nullptr);
+
     // Get the layer widget for the given layer tag.
     UCommonActivatableWidgetContainerBase* GetLayerWidget(FGameplayTag LayerName) const;
 
     // Find the widget if it exists on any of the layers and remove it from the layer.
     void FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* ActivatableWidget);
 
+    // Removes the active widget of each of the layers
+    UFUNCTION(BlueprintCallable, Category = "Layer")
+    void PopLayers(UPARAM(meta = (Categories = "UI.Layer")) const FGameplayTagContainer& LayerNames);
+
+    // Removes every widget of each of the layers, e.g. to drop all menus and modals at once on game over
+    UFUNCTION(BlueprintCallable, Category = "Layer")
+    void ClearLayers(UPARAM(meta = (Categories = "UI.Layer")) const FGameplayTagContainer& LayerNames);
+
 protected:
     // Register a layer that widgets can be pushed onto.
     UFUNCTION(BlueprintCallable, Category = "Layer")
     void RegisterLayer(UPARAM(meta = (Categories = "UI.Layer")) FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget);
 
+    // Records the layer a widget was pushed onto
+    void IndexWidget(FGameplayTag LayerName, UCommonActivatableWidget& Widget);
+
+    // Drops the index entries of widgets that have been destroyed
+    void CompactWidgetIndex();
+
 private:
     // The registered layers for the primary layout.
     UPROPERTY(Transient, meta = (Categories = "UI.Layer"))
-    TMap<FGameplayTag, UCommonActivatableWidgetContainerBase*> Layers;
+    TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
+
+    // The layer each pushed widget went onto. Entries of widgets that left their layer on their own are only dropped on
+    // compaction, so lookups still check the layer.
+    TMap<TObjectKey<UCommonActivatableWidget>, FGameplayTag> WidgetLayers;
+
+    // Size of the widget index that triggers the next compaction
+    int32 CompactWidgetIndexAt = 32;
 };
@@ -9,6 +9,7 @@
 
 class UCommonActivatableWidget;
 class URogueGameLayout;
+class URogueHUDModel;
 
 /**
  * The HUD class is the base actor class of the heads-up display. It has a canvas and a debug canvas on which primitives can be drawn.
@@ -24,9 +25,19 @@ public:
 	// Called when play begins for this actor 
 	virtual void BeginPlay() override; 
 
+	// Called when this actor is being removed from the level
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Getter for the root layout widget 
 	TObjectPtr<URogueGameLayout> GetRootLayoutWidget() { return RootLayoutWidget; }
 
+	// Getter for the model feeding gameplay values to the HUD widgets
+	UFUNCTION(BlueprintPure, Category = "Rogue|UI")
+	URogueHUDModel* GetHUDModel() const { return HUDModel; }
+
+	// Getter for the HUD widget class created during startup
+	const TSoftClassPtr<UCommonActivatableWidget>& GetDefaultWidgetClass() const { return DefaultWidgetClass; }
+
 protected:
 	// Layout class to use to setup the UI layout
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "Rogue|UI")
@@ -42,4 +53,8 @@ protected:
 
 	// The instanced default widget 
 	TObjectPtr<UCommonActivatableWidget> DefaultWidget; 
+
+	// The model feeding gameplay values to the HUD widgets, created before the default widget so it can bind on construct
+	UPROPERTY(Transient)
+	TObjectPtr<URogueHUDModel> HUDModel;
 };
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UI/RogueUITypes.h"
+#include "RogueHUDModel.generated.h"
+
+class APawn;
+class APlayerController;
+class ARogueCharacterBase;
+class ARogueGameState;
+
+// Native and blueprint delegates fired when a HUD value changes
+DECLARE_MULTICAST_DELEGATE_TwoParams(FRogueHUDValueChanged, ERogueHUDValue /*Value*/, int32 /*NewValue*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FRogueHUDValueChangedDynamic, ERogueHUDValue, Value, int32, NewValue);
+
+/**
+ *
+ * Holds the gameplay values shown on the HUD and tells the HUD widgets when they change.
+ * Values are pushed from gameplay events: the hit and hit points added events of the possessed character and the level
+ * timer crossing a whole second. Widgets update their text only from OnValueChanged, so Slate only lays out and paints
+ * them again when something visible changed instead of evaluating bindings every frame.
+ *
+ */
+UCLASS(BlueprintType)
+class SIDESCROLLROGUELIKE_API URogueHUDModel : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Binds to the game state and the pawn of the player controller, and follows the player controller to new pawns
+    void Initialize(APlayerController* PlayerController);
+
+    // Unbinds from everything bound in Initialize
+    void Deinitialize();
+
+    // Returns the current value
+    UFUNCTION(BlueprintPure, Category = "Rogue|UI")
+    int32 GetValue(ERogueHUDValue Value) const;
+
+    // Fired when a value changes
+    FRogueHUDValueChanged OnValueChanged;
+
+    // Fired when a value changes, for blueprint widgets
+    UPROPERTY(BlueprintAssignable, Category = "Rogue|UI")
+    FRogueHUDValueChangedDynamic OnValueChangedBP;
+
+protected:
+    // Callback for when the player controller possesses a new pawn
+    void PawnChanged(APawn* NewPawn);
+
+    // Callback for the hit, hit points added and death events of the character
+    // Must be a UFUNCTION as this is bound to dynamic multicast delegates
+    UFUNCTION()
+    void CharacterHitPointsChanged();
+
+    // Callback for the level timer crossing a whole second
+    void RemainingSecondsChanged(int32 RemainingSeconds);
+
+    // Stores a value and broadcasts it if it changed
+    void SetValue(ERogueHUDValue Value, int32 NewValue);
+
+    // Unbinds from the character events
+    void UnbindCharacter();
+
+protected:
+    // The player controller whose pawn is shown
+    TWeakObjectPtr<APlayerController> OwningPlayerController;
+
+    // The character whose hit points are shown
+    TWeakObjectPtr<ARogueCharacterBase> Character;
+
+    // The game state whose timer is shown
+    TWeakObjectPtr<ARogueGameState> RogueGameState;
+
+    // The current values
+    int32 HitPoints        = 0;
+    int32 RemainingSeconds = 0;
+
+    // Delegate handles for the player controller and game state events
+    FDelegateHandle NewPawnHandle;
+    FDelegateHandle RemainingSecondsHandle;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonUserWidget.h"
+#include "UI/RogueUITypes.h"
+#include "RogueHUDValueWidget.generated.h"
+
+class UCommonTextBlock;
+class UInvalidationBox;
+class URogueHUDModel;
+
+/**
+ * Shows one gameplay value of the HUD model, e.g. the hit points or the time left.
+ * The text is only set when the model reports a change, nothing is bound or ticked. When the widget tree wraps the
+ * text in an invalidation box, Slate keeps the cached layout and draw elements of the value between changes.
+ * Rogue.UI.HUDInvalidation turns the caching off at runtime so stat slate can compare both.
+ */
+UCLASS(Abstract, BlueprintType, meta = (DisableNativeTick))
+class SIDESCROLLROGUELIKE_API URogueHUDValueWidget : public UCommonUserWidget
+{
+    GENERATED_BODY()
+
+public:
+    // Turns the invalidation box caching of the widget on or off
+    void SetCachingEnabled(bool bEnabled);
+
+protected:
+    virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+
+    // Callback for when a value of the model changes
+    void ValueChanged(ERogueHUDValue ChangedValue, int32 NewValue);
+
+    // Returns the text shown for a value
+    FText FormatValue(int32 NewValue) const;
+
+    // Blueprint event for when the shown value changed, e.g. to play an animation
+    UFUNCTION(BlueprintImplementableEvent, Category = "Rogue|UI")
+    void OnValueChanged_BP(int32 NewValue);
+
+protected:
+    // The value this widget shows
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Rogue|UI")
+    ERogueHUDValue Value = ERogueHUDValue::HitPoints;
+
+    // The text showing the value
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidget), Category = "Rogue|UI")
+    TObjectPtr<UCommonTextBlock> ValueText;
+
+    // Optional invalidation box around the text
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional), Category = "Rogue|UI")
+    TObjectPtr<UInvalidationBox> InvalidationBox;
+
+    // The model the value comes from
+    TWeakObjectPtr<URogueHUDModel> HUDModel;
+
+    // Delegate handle for the model's value changes
+    FDelegateHandle ValueChangedHandle;
+};
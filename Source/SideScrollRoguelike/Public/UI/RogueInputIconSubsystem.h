@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonInputTypeEnum.h"
+#include "Containers/Ticker.h"
+#include "Styling/SlateBrush.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "RogueInputIconSubsystem.generated.h"
+
+// Log category for the Rogue Input Icon Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueInputIcon, Log, All);
+
+/**
+ *
+ * Caches the CommonUI input brushes of keys, keyed by key, input type and gamepad name.
+ * Widgets read brushes from the cache instead of resolving them through the platform settings while painting.
+ *
+ * When the input method changes, the brushes of every key in the active key profile are resolved for the new input type
+ * and gamepad, a few keys per frame so the switch does not hitch. A key that was not preloaded is resolved on first use.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueInputIconSubsystem : public ULocalPlayerSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //--- USubsystem overrides
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+    void Deinitialize() override;
+    //--- End USubsystem
+
+    // Returns the brush of a key for the input type and gamepad, or the empty brush when the platform has none.
+    // The reference is only valid until the next lookup, copy the brush to keep it.
+    const FSlateBrush& GetInputBrush(const FKey& Key, ECommonInputType InputType, FName GamepadName);
+
+    // Returns the brush of a key for the current input type and gamepad
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    FSlateBrush GetCurrentInputBrush(FKey Key);
+
+protected:
+    // Callback for when the active input method changes
+    void InputMethodChanged(ECommonInputType NewInputType);
+
+    // Queues the keys of the active key profile that can be used with the input type
+    void QueuePreload(ECommonInputType InputType, FName GamepadName);
+
+    // Resolves a few of the queued brushes each frame
+    bool PreloadQueuedBrushes(float DeltaTime);
+
+    // Resolves a brush through the platform settings and stores it
+    const FSlateBrush& ResolveBrush(const FKey& Key, ECommonInputType InputType, FName GamepadName);
+
+protected:
+    // The key of a cached brush
+    struct FBrushKey
+    {
+        FKey Key;
+        ECommonInputType InputType = ECommonInputType::MouseAndKeyboard;
+        FName GamepadName;
+
+        bool operator==(const FBrushKey& Other) const
+        {
+            return Key == Other.Key && InputType == Other.InputType && GamepadName == Other.GamepadName;
+        }
+
+        friend uint32 GetTypeHash(const FBrushKey& BrushKey)
+        {
+            return HashCombine(HashCombine(GetTypeHash(BrushKey.Key), GetTypeHash(BrushKey.InputType)), GetTypeHash(BrushKey.GamepadName));
+        }
+    };
+
+    // The resolved brushes. Keys without an icon are stored with an empty brush so they are not looked up again.
+    TMap<FBrushKey, FSlateBrush> Brushes;
+
+    // Brushes waiting to be resolved by the preload ticker
+    TArray<FBrushKey> PreloadQueue;
+
+    // Ticker resolving the preload queue
+    FTSTicker::FDelegateHandle PreloadTickerHandle;
+
+    // Number of brushes resolved outside of a preload, i.e. on the paint path
+    int32 NumMisses = 0;
+};
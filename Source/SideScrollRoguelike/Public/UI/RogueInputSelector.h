@@ -10,6 +10,7 @@
 #include "RogueInputSelector.generated.h"
 
 class UCommonInputSubsystem;
+struct FRogueKeyMappingView;
 
 // Log Category for the Rogue Input Selector
 DECLARE_LOG_CATEGORY_EXTERN(LogRogueInputSelector, Log, All);
@@ -60,10 +61,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
     bool ChangeBinding(int32 InKeyBindSlot, FKey NewKey, bool bUpdateOverlappingKeys = true);
 
+    // Remaps several slots with the same new key in one rebind transaction, with a single mapping context rebuild and save
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    bool ChangeBindings(const TArray<int32>& InKeyBindSlots, FKey NewKey, bool bUpdateOverlappingKeys = true);
+
     // Returns true if mapping on this selector has been customized
     UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
     bool IsMappingCustomized() const;
 
+    // Gets the mapping name of the Input Action, none until InitializeInputData found a mapping passing the query
+    FName GetActionMappingName() const { return ActionMappingName; }
+
     // Gets the display name of the Input Action
     UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
     FText GetActionMappingDisplayName() const;
@@ -88,6 +96,12 @@ public:
     // Gets the CommonInput subsystem from the local player
     TObjectPtr<UCommonInputSubsystem> GetCommonInputSubsystem() const;
 
+    // Drops the key mapping index views after this selector changed a mapping
+    void InvalidateMappingIndex() const;
+
+    // Asks the settings persistence subsystem to save the key profile once the player is done rebinding
+    void RequestSaveSettings(UEnhancedInputUserSettings* Settings) const;
+
     // Invoked whenever this widget is selected by a mouse button while it has focus
     // Note that this function can also be invoked via "virtual accept" keys on the gamepad.
     virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
@@ -144,6 +158,13 @@ protected:
     // Returns the mapping row from the player mappable key profile
     const FKeyMappingRow* FindKeyMappingRow() const;
 
+    // Returns the mappings of this selector's action that pass its query options, from the local player's key mapping index.
+    // The view is invalidated by any rebind.
+    const FRogueKeyMappingView* FindIndexedMappings() const;
+
+    // Checks a slot against the slot of the query options
+    bool DoesSlotPassQueryOptions(EPlayerMappableKeySlot Slot) const;
+
     // Checks if A and B are the same logical key type
     bool DoKeyTypesMatch(const FKey& A, const FKey& B);
 
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+#include "RogueKeyMappingIndexSubsystem.generated.h"
+
+// Log category for the Rogue Key Mapping Index Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueKeyMappingIndex, Log, All);
+
+// A mapping of a row that passed a query, reduced to what the input selectors read
+struct FRogueIndexedKeyMapping
+{
+    EPlayerMappableKeySlot Slot = EPlayerMappableKeySlot::Unspecified;
+    FKey CurrentKey;
+    bool bCustomized = false;
+};
+
+// The mappings of one action that pass one set of query options, regardless of slot
+struct FRogueKeyMappingView
+{
+    TArray<FRogueIndexedKeyMapping, TInlineAllocator<4>> Mappings;
+
+    // True when the action has a row in the key profile
+    bool bHasRow = false;
+
+    // Returns the mapping in the given slot, or any mapping for EPlayerMappableKeySlot::Unspecified
+    const FRogueIndexedKeyMapping* FindSlot(EPlayerMappableKeySlot Slot) const
+    {
+        return Mappings.FindByPredicate([Slot](const FRogueIndexedKeyMapping& Mapping)
+        {
+            return Slot == EPlayerMappableKeySlot::Unspecified || Mapping.Slot == Slot;
+        });
+    }
+
+    // Returns the last mapping in the given slot, or the last mapping for EPlayerMappableKeySlot::Unspecified
+    const FRogueIndexedKeyMapping* FindLastSlot(EPlayerMappableKeySlot Slot) const
+    {
+        for (int32 Index = Mappings.Num() - 1; Index >= 0; --Index)
+        {
+            if (Slot == EPlayerMappableKeySlot::Unspecified || Mappings[Index].Slot == Slot)
+            {
+                return &Mappings[Index];
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ *
+ * Answers the key mapping queries of the input selectors without walking the key profile every time.
+ * Each view is built the first time an action is queried with a given key type, using the key profile's own query
+ * check, and reused until Enhanced Input reports a change to the mappings or the active key profile.
+ *
+ * Views are invalidated by any change, so do not hold on to a view across a call that maps or unmaps keys.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueKeyMappingIndexSubsystem : public ULocalPlayerSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //--- USubsystem overrides
+    void Deinitialize() override;
+    //--- End USubsystem
+
+    // Returns the mappings of an action in a key profile that pass the query options. The slot of the options is ignored,
+    // filter with FRogueKeyMappingView::FindSlot. Returns null when the profile does not exist.
+    const FRogueKeyMappingView* FindMappings(const FString& ProfileId, FName MappingName, const FPlayerMappableKeyQueryOptions& QueryOptions);
+
+    // Drops all views, they are rebuilt on the next query
+    void Invalidate();
+
+protected:
+    // Gets the Enhanced Input user settings of the local player
+    UEnhancedInputUserSettings* GetUserSettings() const;
+
+    // Binds to the change events of the user settings the views were built from
+    void BindToUserSettings(UEnhancedInputUserSettings* Settings);
+
+    // Called by Enhanced Input when the settings changed, including any key mapping
+    UFUNCTION()
+    void UserSettingsChanged(UEnhancedInputUserSettings* Settings);
+
+    // Called by Enhanced Input when the active key profile changed
+    UFUNCTION()
+    void KeyProfileChanged(const UEnhancedPlayerMappableKeyProfile* NewProfile);
+
+protected:
+    // The key of a view: the action and the parts of the query options that select a key type or device
+    struct FQueryKey
+    {
+        FString ProfileId;
+        FName MappingName;
+        FName KeyToMatch;
+        EHardwareDevicePrimaryType RequiredDeviceType = EHardwareDevicePrimaryType::Unspecified;
+        int32 RequiredDeviceFlags                     = 0;
+        bool bMatchBasicKeyTypes                      = false;
+        bool bMatchKeyAxisType                        = false;
+
+        bool operator==(const FQueryKey& Other) const
+        {
+            return MappingName == Other.MappingName && KeyToMatch == Other.KeyToMatch && RequiredDeviceType == Other.RequiredDeviceType && RequiredDeviceFlags == Other.RequiredDeviceFlags
+                && bMatchBasicKeyTypes == Other.bMatchBasicKeyTypes && bMatchKeyAxisType == Other.bMatchKeyAxisType && ProfileId == Other.ProfileId;
+        }
+
+        friend uint32 GetTypeHash(const FQueryKey& Key)
+        {
+            uint32 Hash = HashCombine(GetTypeHash(Key.ProfileId), GetTypeHash(Key.MappingName));
+            Hash        = HashCombine(Hash, GetTypeHash(Key.KeyToMatch));
+            Hash        = HashCombine(Hash, GetTypeHash(Key.RequiredDeviceType));
+            Hash        = HashCombine(Hash, GetTypeHash(Key.RequiredDeviceFlags));
+            return HashCombine(Hash, (Key.bMatchBasicKeyTypes ? 1u : 0u) | (Key.bMatchKeyAxisType ? 2u : 0u));
+        }
+    };
+
+    // The views built since the last change
+    TMap<FQueryKey, FRogueKeyMappingView> Views;
+
+    // The user settings whose change events are bound
+    TWeakObjectPtr<UEnhancedInputUserSettings> BoundUserSettings;
+
+    // Number of views built and reused, logged when the index is invalidated
+    int32 NumBuilds = 0;
+    int32 NumHits   = 0;
+};
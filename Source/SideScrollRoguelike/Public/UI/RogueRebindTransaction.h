@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UserSettings/EnhancedInputUserSettings.h"
+#include "RogueRebindTransaction.generated.h"
+
+class ULocalPlayer;
+
+// Log category for the Rogue Rebind Transaction
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueRebindTransaction, Log, All);
+
+// A key that would end up on more than one action after a rebind transaction
+USTRUCT(BlueprintType)
+struct FRogueRebindConflict
+{
+    GENERATED_BODY()
+
+    // The key mapped more than once
+    UPROPERTY(BlueprintReadOnly, Category = "Rogue|Input")
+    FKey Key;
+
+    // The actions the key would be mapped to
+    UPROPERTY(BlueprintReadOnly, Category = "Rogue|Input")
+    TArray<FName> MappingNames;
+};
+
+/**
+ *
+ * Batches any number of key map, unmap, swap and reset operations on the active key profile of a local player.
+ * Operations are only recorded when queued. Commit plays them against a copy of the current bindings, checks the result
+ * for conflicts in one pass and applies the changed mappings through MapPlayerKey and UnMapPlayerKey of the user settings,
+ * holding back the change broadcast they send for each key. Enhanced Input is then told about the change once, so the
+ * mapping contexts are rebuilt and the settings saved once per transaction instead of once per key.
+ *
+ */
+UCLASS(BlueprintType)
+class SIDESCROLLROGUELIKE_API URogueRebindTransaction : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // Starts a transaction on the active key profile of the local player. Returns null without Enhanced Input user settings.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    static URogueRebindTransaction* BeginRebind(ULocalPlayer* LocalPlayer);
+
+    // Maps a key to a slot of an action. With bSwapOverlapping, an action already using the key gets this slot's old key.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    void QueueMap(FName MappingName, EPlayerMappableKeySlot Slot, FKey NewKey, bool bSwapOverlapping = true);
+
+    // Clears the key of a slot of an action
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    void QueueUnmap(FName MappingName, EPlayerMappableKeySlot Slot);
+
+    // Puts a slot of an action back to its default key, every slot for EPlayerMappableKeySlot::Unspecified
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    void QueueResetToDefault(FName MappingName, EPlayerMappableKeySlot Slot = EPlayerMappableKeySlot::Unspecified);
+
+    // Plays the queued operations and returns the keys that would be mapped to more than one action
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    TArray<FRogueRebindConflict> Validate();
+
+    // Applies the queued operations. Fails without changing anything when there are conflicts, unless they are allowed.
+    UFUNCTION(BlueprintCallable, Category = "Rogue|Input")
+    bool Commit(bool bAllowConflicts = false);
+
+    // Number of mappings changed by the last commit
+    UFUNCTION(BlueprintPure, Category = "Rogue|Input")
+    int32 GetNumChanges() const { return NumChanges; }
+
+    // Number of swaps done for overlapping keys by the last commit
+    UFUNCTION(BlueprintPure, Category = "Rogue|Input")
+    int32 GetNumSwaps() const { return NumSwaps; }
+
+    // Number of mapping context rebuilds requested by the last commit
+    UFUNCTION(BlueprintPure, Category = "Rogue|Input")
+    int32 GetNumRebuildRequests() const { return NumRebuildRequests; }
+
+    // When false, Commit does not request a settings save. True by default.
+    bool bSaveOnCommit = true;
+
+    // What RunResetBenchmark measured
+    struct FResetBenchmarkResult
+    {
+        int32 NumActions          = 0;
+        double PerActionMs        = 0.0;
+        int32 PerActionRebuilds   = 0;
+        double TransactionMs      = 0.0;
+        int32 TransactionRebuilds = 0;
+        int32 TransactionChanges  = 0;
+    };
+
+    // Resets a number of customized actions to default once per action and once as a transaction, and logs the cost and
+    // mapping context rebuilds of both. The bindings are put back afterwards. Returns false when there is nothing to measure.
+    // See Rogue.Input.RebindBenchmark and the Rogue.Input.RebindBenchmark automation test.
+    static bool RunResetBenchmark(ULocalPlayer* LocalPlayer, int32 NumActions, FResetBenchmarkResult* OutResult = nullptr);
+
+protected:
+    // A slot of an action
+    struct FSlotKey
+    {
+        FName MappingName;
+        EPlayerMappableKeySlot Slot = EPlayerMappableKeySlot::Unspecified;
+
+        bool operator==(const FSlotKey& Other) const { return MappingName == Other.MappingName && Slot == Other.Slot; }
+        friend uint32 GetTypeHash(const FSlotKey& SlotKey) { return HashCombine(GetTypeHash(SlotKey.MappingName), GetTypeHash(SlotKey.Slot)); }
+    };
+
+    // A queued operation
+    struct FOperation
+    {
+        enum class EType : uint8
+        {
+            Map,
+            Unmap,
+            Reset
+        };
+
+        EType Type = EType::Map;
+        FSlotKey Target;
+        FKey NewKey;
+        bool bSwapOverlapping = false;
+    };
+
+    // Reads the current bindings and defaults of the key profile
+    void CaptureProfile();
+
+    // Plays the queued operations on a copy of the current bindings
+    void PlanChanges();
+
+    // Counts settings change broadcasts while a benchmark runs, each one requests a mapping context rebuild
+    UFUNCTION()
+    void CountSettingsChanged(UEnhancedInputUserSettings* ChangedSettings);
+
+protected:
+    // The local player whose key profile is rebound
+    TWeakObjectPtr<ULocalPlayer> OwningLocalPlayer;
+
+    // The settings and profile the transaction applies to
+    TWeakObjectPtr<UEnhancedInputUserSettings> Settings;
+    TWeakObjectPtr<UEnhancedPlayerMappableKeyProfile> Profile;
+
+    // The operations in the order they were queued
+    TArray<FOperation> Operations;
+
+    // The bindings and default keys of the profile when the transaction started
+    TMap<FSlotKey, FKey> CurrentKeys;
+    TMap<FSlotKey, FKey> DefaultKeys;
+
+    // The bindings after the queued operations
+    TMap<FSlotKey, FKey> PlannedKeys;
+
+    // Results of the last plan or commit
+    int32 NumChanges         = 0;
+    int32 NumSwaps           = 0;
+    int32 NumRebuildRequests = 0;
+
+    // Settings change broadcasts seen by CountSettingsChanged
+    int32 NumSettingsChangedBroadcasts = 0;
+};
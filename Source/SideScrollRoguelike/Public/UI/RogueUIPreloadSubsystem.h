@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "RogueUIPreloadSubsystem.generated.h"
+
+class AGameModeBase;
+class UCommonActivatableWidget;
+struct FStreamableHandle;
+struct FWorldInitializationValues;
+
+// Log category for the Rogue UI Preload Subsystem
+DECLARE_LOG_CATEGORY_EXTERN(LogRogueUIPreload, Log, All);
+
+/**
+ *
+ * Streams in the UI classes that are needed right after a map loads, so nothing on the UI path blocks the game thread.
+ * The screen classes listed in the developer settings are requested when the game instance starts. When a game world
+ * initializes, the default widget of its HUD is requested as well, while the loading screen is still covering the map load.
+ *
+ * Everything loaded here is kept in memory for the lifetime of the game instance.
+ *
+ */
+UCLASS()
+class SIDESCROLLROGUELIKE_API URogueUIPreloadSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //--- USubsystem overrides
+    void Initialize(FSubsystemCollectionBase& Collection) override;
+    void Deinitialize() override;
+    //--- End USubsystem
+
+    // Requests a widget class and keeps it in memory. Does nothing for classes that were already requested.
+    void PreloadWidgetClass(const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass);
+
+    // Returns true once every requested class is in memory
+    UFUNCTION(BlueprintPure, Category = "Rogue|UI")
+    bool IsPreloadComplete() const;
+
+protected:
+    // Callback for world initialization
+    void WorldInitialization(UWorld* World, const FWorldInitializationValues IVS);
+
+    // Requests the default widget of the HUD used by the game mode
+    void PreloadHUDWidget(TSubclassOf<AGameModeBase> GameModeClass);
+
+    // Called when a requested class has loaded
+    void WidgetClassLoaded(FSoftObjectPath WidgetClassPath);
+
+protected:
+    // Handles keeping the requested classes in memory
+    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> PreloadHandles;
+
+    // Time the game instance started, for logging how long the preloads took
+    double PreloadStartTime = 0.0;
+
+    // Delegate handle for world creation
+    FDelegateHandle PostWorldCreationHandle;
+};
@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+#include "RogueUITypes.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("RogueUI"), STATGROUP_RogueUI, STATCAT_Advanced);
+
+// The gameplay values shown on the HUD
+UENUM(BlueprintType)
+enum class ERogueHUDValue : uint8
+{
+    HitPoints,
+    RemainingSeconds
+};
@@ -10,6 +10,10 @@
 
 class UCommonActivatableWidget;
 struct FGameplayTag;
+struct FGameplayTagContainer;
+
+// Called once a streamed widget has been pushed, with null when it could not be
+DECLARE_DYNAMIC_DELEGATE_OneParam(FRogueStreamedContentPushed, UCommonActivatableWidget*, Widget);
 
 // Log category for the Rogue UI Blueprint Library 
 DECLARE_LOG_CATEGORY_EXTERN(LogUserInterfaceBlueprintLibrary, Log, All);
@@ -29,6 +33,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Rogue|UI")
 	static UCommonActivatableWidget* PushContentToLayerForPlayer(const APlayerController* PlayerController, UPARAM(meta = (Categories = "UI.Layer")) FGameplayTag LayerName, UPARAM(meta = (AllowAbstract = false)) TSubclassOf<UCommonActivatableWidget> WidgetClass);
 
+	// Streams in the widget class if needed and adds a new widget of it to the target layer without blocking the game thread.
+	// OnPushed is called with the new widget once it is on the layer
+	UFUNCTION(BlueprintCallable, Category = "Rogue|UI", meta = (AutoCreateRefTerm = "OnPushed"))
+	static void PushStreamedContentToLayerForPlayer(const APlayerController* PlayerController, UPARAM(meta = (Categories = "UI.Layer")) FGameplayTag LayerName, UPARAM(meta = (AllowAbstract = false)) TSoftClassPtr<UCommonActivatableWidget> WidgetClass, const FRogueStreamedContentPushed& OnPushed);
+
+	// Removes every widget of the target layers in one go, e.g. the menus and modals when the run ends
+	UFUNCTION(BlueprintCallable, Category = "Rogue|UI")
+	static void ClearLayersForPlayer(const APlayerController* PlayerController, UPARAM(meta = (Categories = "UI.Layer")) const FGameplayTagContainer& LayerNames);
+
 	// Toggles the player's ability to use gamepad navigation in UMG 
 	UFUNCTION(BlueprintCallable, Category = "Rogue|UI")
 	static void SetNavigationEnabled(bool bIsNavEnabled); 